@@ -0,0 +1,123 @@
+/*
+  ==============================================================================
+
+    AllocationTrap.cpp
+
+  ==============================================================================
+*/
+
+#include "AllocationTrap.h"
+
+#if TINGE_ALLOCATION_TRAP
+
+namespace
+{
+    thread_local bool armed = false;
+
+    void trapHeapUse(void* pointer)
+    {
+        if (!armed || pointer == nullptr)
+            return;
+
+        // disarm first, the assertion itself may allocate
+        armed = false;
+        jassertfalse; // heap used inside processBlock
+        armed = true;
+    }
+
+    void* allocate(std::size_t size)
+    {
+        void* pointer = std::malloc(size == 0 ? 1 : size);
+        if (pointer == nullptr)
+            throw std::bad_alloc();
+
+        trapHeapUse(pointer);
+        return pointer;
+    }
+
+    void release(void* pointer) noexcept
+    {
+        trapHeapUse(pointer);
+        std::free(pointer);
+    }
+
+    void* allocateNoThrow(std::size_t size) noexcept
+    {
+        void* pointer = std::malloc(size == 0 ? 1 : size);
+        trapHeapUse(pointer);
+        return pointer;
+    }
+
+    // over-aligned types, freed with the matching aligned delete
+    void* allocateAligned(std::size_t size, std::align_val_t alignment, const std::nothrow_t&) noexcept
+    {
+        void* pointer = nullptr;
+       #if JUCE_WINDOWS
+        pointer = _aligned_malloc(size == 0 ? 1 : size, (std::size_t)alignment);
+       #else
+        if (posix_memalign(&pointer, std::max((std::size_t)alignment, sizeof(void*)), size == 0 ? 1 : size) != 0)
+            pointer = nullptr;
+       #endif
+        trapHeapUse(pointer);
+        return pointer;
+    }
+
+    void* allocateAligned(std::size_t size, std::align_val_t alignment)
+    {
+        void* pointer = allocateAligned(size, alignment, std::nothrow);
+        if (pointer == nullptr)
+            throw std::bad_alloc();
+
+        return pointer;
+    }
+
+    void releaseAligned(void* pointer) noexcept
+    {
+        trapHeapUse(pointer);
+       #if JUCE_WINDOWS
+        _aligned_free(pointer);
+       #else
+        std::free(pointer);
+       #endif
+    }
+}
+
+ScopedAllocationTrap::ScopedAllocationTrap() : wasArmed(armed)
+{
+    armed = true;
+}
+
+ScopedAllocationTrap::~ScopedAllocationTrap()
+{
+    armed = wasArmed;
+}
+
+bool ScopedAllocationTrap::isArmed()
+{
+    return armed;
+}
+
+void* operator new (std::size_t size)                         { return allocate(size); }
+void* operator new[] (std::size_t size)                       { return allocate(size); }
+void operator delete (void* pointer) noexcept                 { release(pointer); }
+void operator delete[] (void* pointer) noexcept               { release(pointer); }
+void operator delete (void* pointer, std::size_t) noexcept    { release(pointer); }
+void operator delete[] (void* pointer, std::size_t) noexcept  { release(pointer); }
+
+void* operator new (std::size_t size, const std::nothrow_t&) noexcept        { return allocateNoThrow(size); }
+void* operator new[] (std::size_t size, const std::nothrow_t&) noexcept      { return allocateNoThrow(size); }
+void operator delete (void* pointer, const std::nothrow_t&) noexcept         { release(pointer); }
+void operator delete[] (void* pointer, const std::nothrow_t&) noexcept       { release(pointer); }
+
+void* operator new (std::size_t size, std::align_val_t alignment)             { return allocateAligned(size, alignment); }
+void* operator new[] (std::size_t size, std::align_val_t alignment)           { return allocateAligned(size, alignment); }
+void* operator new (std::size_t size, std::align_val_t alignment, const std::nothrow_t&) noexcept    { return allocateAligned(size, alignment, std::nothrow); }
+void* operator new[] (std::size_t size, std::align_val_t alignment, const std::nothrow_t&) noexcept  { return allocateAligned(size, alignment, std::nothrow); }
+void operator delete (void* pointer, std::align_val_t) noexcept                                     { releaseAligned(pointer); }
+void operator delete[] (void* pointer, std::align_val_t) noexcept                                   { releaseAligned(pointer); }
+void operator delete (void* pointer, std::size_t, std::align_val_t) noexcept                        { releaseAligned(pointer); }
+void operator delete[] (void* pointer, std::size_t, std::align_val_t) noexcept                      { releaseAligned(pointer); }
+void operator delete (void* pointer, std::align_val_t, const std::nothrow_t&) noexcept              { releaseAligned(pointer); }
+void operator delete[] (void* pointer, std::align_val_t, const std::nothrow_t&) noexcept            { releaseAligned(pointer); }
+
+#endif
@@ -0,0 +1,38 @@
+/*
+  ==============================================================================
+
+    AllocationTrap.h
+
+  ==============================================================================
+*/
+
+#pragma once
+#include <JuceHeader.h>
+
+// replaces the global operator new/delete in debug builds to catch heap use on the audio thread
+#ifndef TINGE_ALLOCATION_TRAP
+ #if JUCE_DEBUG
+  #define TINGE_ALLOCATION_TRAP 1
+ #else
+  #define TINGE_ALLOCATION_TRAP 0
+ #endif
+#endif
+
+// asserts if the current thread allocates or frees while this is in scope
+class ScopedAllocationTrap
+{
+public:
+   #if TINGE_ALLOCATION_TRAP
+    ScopedAllocationTrap();
+    ~ScopedAllocationTrap();
+
+    static bool isArmed();
+
+private:
+    bool wasArmed;
+   #else
+    ScopedAllocationTrap() {}
+   #endif
+
+    JUCE_DECLARE_NON_COPYABLE (ScopedAllocationTrap)
+};
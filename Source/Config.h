@@ -0,0 +1,17 @@
+/*
+  ==============================================================================
+
+    Config.h
+
+  ==============================================================================
+*/
+
+#pragma once
+
+// spinners run by the engine, raise for denser polyrhythms.
+// the editor draws and edits the first editorSpinners of them.
+constexpr int numSpinners = 3;
+constexpr int editorSpinners = 3;
+
+static_assert (numSpinners >= editorSpinners, "the editor needs three spinners to draw");
+static_assert (numSpinners <= 32, "active spinners are counted in a 32 bit mask");
@@ -0,0 +1,95 @@
+/*
+  ==============================================================================
+
+    CrossingEngine.cpp
+
+  ==============================================================================
+*/
+
+#include "CrossingEngine.h"
+
+void CrossingEngine::clear()
+{
+    numCrossings = 0;
+}
+
+void CrossingEngine::addSpinner(int spinner, const Segment& segment, float shape,
+                                const std::array<float, 16>& thresholdAngles, int numThresholds,
+                                int startSample, int numSamples)
+{
+    if (segment.increment == 0.0 || numSamples <= 1)
+        return;
+
+    for (int i = 0; i < numThresholds; i++)
+    {
+        // the window is (phase, phase + shape], so a threshold leaves it when the
+        // start edge passes and enters it when the end edge passes
+        double exitAngle = thresholdAngles[i];
+        double enterAngle = exitAngle - shape;
+        enterAngle -= std::floor(enterAngle);
+
+        addEdge(spinner, i, uncurvePhase(exitAngle, segment.curve), false, segment, startSample, numSamples);
+        addEdge(spinner, i, uncurvePhase(enterAngle, segment.curve), true, segment, startSample, numSamples);
+    }
+}
+
+void CrossingEngine::addEdge(int spinner, int threshold, double edgePhase, bool insideWhenForward,
+                             const Segment& segment, int startSample, int numSamples)
+{
+    const double start = segment.startPhase;
+    const double increment = segment.increment;
+    const bool isForward = increment > 0.0;
+
+    // nearest wrap of the edge ahead of the spinner in its direction of travel
+    double target = isForward ? edgePhase + std::floor(start - edgePhase) + 1.0
+                              : edgePhase + std::ceil(start - edgePhase) - 1.0;
+
+    while (true)
+    {
+        double crossingTime = (target - start) / increment;
+        if (crossingTime >= numSamples)
+            break;
+
+        // first sample that lands past the edge, the last sample of the segment
+        // is picked up by the interaction at the start of the next one
+        int sample = isForward ? (int)std::ceil(crossingTime) : (int)std::floor(crossingTime) + 1;
+        if (sample >= numSamples)
+            break;
+
+        if (numCrossings == maxCrossings)
+        {
+            jassertfalse; // more wraps per block than the engine can hold
+            break;
+        }
+
+        crossings[numCrossings++] = { startSample + sample, spinner, threshold, isForward == insideWhenForward };
+        target += isForward ? 1.0 : -1.0;
+    }
+}
+
+void CrossingEngine::sort()
+{
+    std::sort(crossings.begin(), crossings.begin() + numCrossings, [](const Crossing& a, const Crossing& b)
+    {
+        if (a.samplePosition != b.samplePosition)
+            return a.samplePosition < b.samplePosition;
+
+        if (a.spinner != b.spinner)
+            return a.spinner < b.spinner;
+
+        return a.threshold < b.threshold;
+    });
+}
+
+double CrossingEngine::uncurvePhase(double curvedPhase, float curve)
+{
+    // inverse of Spinner::getCurvedPhase
+    if (curve == 1.0f) return curvedPhase;
+
+    if (curve > 1.0f)
+    {
+        return std::pow(curvedPhase, 1.0 / curve);
+    } else {
+        return 1.0 - std::pow(1.0 - curvedPhase, 1.0 / curve);
+    }
+}
@@ -0,0 +1,51 @@
+/*
+  ==============================================================================
+
+    CrossingEngine.h
+
+  ==============================================================================
+*/
+
+#pragma once
+#include <JuceHeader.h>
+
+class CrossingEngine
+{
+public:
+    // linear motion of one spinner over a block, before the curve is applied
+    struct Segment
+    {
+        double startPhase = 0.0; // wrapped to 0-1, phase offset included
+        double increment = 0.0;  // phase travelled per sample
+        float curve = 1.0f;
+    };
+
+    // a spinner window edge passing a threshold angle
+    struct Crossing
+    {
+        int samplePosition;
+        int spinner;
+        int threshold;
+        bool isInside;
+    };
+
+    void clear();
+    void addSpinner(int spinner, const Segment& segment, float shape,
+                    const std::array<float, 16>& thresholdAngles, int numThresholds,
+                    int startSample, int numSamples);
+    void sort();
+
+    int size() const { return numCrossings; }
+    const Crossing& operator[](int index) const { return crossings[index]; }
+
+    static double uncurvePhase(double curvedPhase, float curve);
+
+    static constexpr int maxCrossings = 512;
+
+private:
+    void addEdge(int spinner, int threshold, double edgePhase, bool insideWhenForward,
+                 const Segment& segment, int startSample, int numSamples);
+
+    std::array<Crossing, maxCrossings> crossings;
+    int numCrossings = 0;
+};
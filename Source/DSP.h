@@ -4,15 +4,28 @@
 class LowPassGate
 {
 public:
+    LowPassGate()
+    {
+        updateCoefficients();
+    }
+    
     void setSampleRate(double sampleRate)
     {
+        if (this->sampleRate == sampleRate)
+            return;
+        
         this->sampleRate = sampleRate;
+        updateCoefficients();
     }
 
     void setEnvelopeSlew(float riseInMilliseconds, float fallInMilliseconds)
     {
-        envelopeRise = (riseInMilliseconds/1000.0f) * sampleRate;
-        envelopeFall = (fallInMilliseconds/1000.0f) * sampleRate;
+        if (riseTime == riseInMilliseconds && fallTime == fallInMilliseconds)
+            return;
+        
+        riseTime = riseInMilliseconds;
+        fallTime = fallInMilliseconds;
+        updateCoefficients();
     }
 
     void triggerEnvelope(bool gateInput)
@@ -29,26 +42,73 @@ public:
     
     float generateEnvelope()
     {
-        bool gateThreshold = gate >= 0.5f;
-        
-        float segmentSelect = gateThreshold ? envelopeRise : envelopeFall;
-        segmentSelect = std::max(segmentSelect, 1.0f);
+        float coefficient = getCoefficient();
         
-        float segmentTimeT60 = processT60(segmentSelect);
-        envelope = (1.0f - segmentTimeT60) * gate + segmentTimeT60 * unitDelay;
+        envelope = gate + coefficient * (unitDelay - gate);
         if (std::abs(envelope) < 1e-15f) // denormal clearing
             envelope = 0.0f;
+        if (std::abs(envelope - gate) < settleThreshold) // land exactly on the gate
+            envelope = gate;
         
         unitDelay = envelope;
         return envelope;
     }
     
+    void generateEnvelope(float* output, int numSamples)
+    {
+        int sample = 0;
+        for (; sample < numSamples && !isSettled(); ++sample){
+            output[sample] = generateEnvelope();
+        }
+        
+        if (sample < numSamples)
+            juce::FloatVectorOperations::fill(output + sample, envelope, numSamples - sample);
+    }
+    
     bool isActive()
     {
         return envelope > 0.0001f;
     }
+    
+    // envelope has reached the gate and will keep returning it
+    bool isSettled() const
+    {
+        return envelope == gate;
+    }
+    
+    float getEnvelope() const
+    {
+        return envelope;
+    }
+    
+    float getGate() const
+    {
+        return gate;
+    }
+    
+    // coefficient generateEnvelope() uses for the current gate
+    float getCoefficient() const
+    {
+        return gate >= 0.5f ? riseCoefficient : fallCoefficient;
+    }
+    
+    // hand back an envelope rendered outside the gate, e.g. by the spinner bank
+    void setEnvelope(float newEnvelope)
+    {
+        envelope = newEnvelope;
+        unitDelay = newEnvelope;
+    }
 
 private:
+    void updateCoefficients()
+    {
+        envelopeRise = (riseTime/1000.0f) * sampleRate;
+        envelopeFall = (fallTime/1000.0f) * sampleRate;
+        
+        riseCoefficient = processT60(std::max(envelopeRise, 1.0f));
+        fallCoefficient = processT60(std::max(envelopeFall, 1.0f));
+    }
+    
     float processT60(float input)
     {
         float t60 = std::exp(safediv(-6.9077552789821f, input));
@@ -64,7 +124,9 @@ private:
     double sampleRate = 0.0;
     float unitDelay = 0.0f;
     static constexpr float epsilon = 1e-6f; // safety for dividing by 0
+    static constexpr float settleThreshold = 1e-6f;
+    float riseTime = 0.0f, fallTime = 0.0f;
     float envelopeRise = 0.0f, envelopeFall = 0.0f;
+    float riseCoefficient = 0.0f, fallCoefficient = 0.0f;
     float gate = 0.0f, lastGate = 0.0f, envelope = 0.0f;
 };
-
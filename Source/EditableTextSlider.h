@@ -1,16 +1,18 @@
 
 #pragma once
 #include <JuceHeader.h>
+#include "PluginProcessor.h"
 #include "LookAndFeel.h"
+#include "ParameterRegistry.h"
 
-enum class UnitStyle { Int, Float, Percent, Hertz, Sync };
-
-class EditableTextBoxSlider : public juce::Component, juce::Timer, juce::AudioProcessorParameter::Listener, juce::AsyncUpdater, juce::Label::Listener
+class EditableTextBoxSlider : public juce::Component, ParameterInstance::Listener, juce::Label::Listener
 {
 public:
-    EditableTextBoxSlider(TingeAudioProcessor& p, juce::String parameterID) : audioProcessor(p)
+    EditableTextBoxSlider(TingeAudioProcessor& p, int parameterIndex) : audioProcessor(p)
     {
-        this->parameterID = parameterID;
+        this->parameterIndex = parameterIndex;
+        parameter = audioProcessor.params->getParameterByIndex(parameterIndex);
+        instance = &audioProcessor.params->getByIndex(parameterIndex);
         
         addAndMakeVisible(textBox);
         textBox.setEditable(false, false, false);
@@ -23,26 +25,19 @@ public:
         textBox.addListener(this);
         
         // initialize parameter ranges
-        juce::NormalisableRange range = audioProcessor.params->apvts.getParameterRange(parameterID);
+        juce::NormalisableRange range = parameter->getNormalisableRange();
         rangeStart = range.start;
         rangeEnd = range.end;
         
-        // add listener
-        const auto params = audioProcessor.getParameters();
-        for (auto param : params){
-            param->addListener(this);
-        }
+        // only this box's parameter, coalesced by the editor's frame poll
+        instance->addListener(this);
         
-        // start timer
-        startTimerHz(30);
+        setMouseCursor(juce::MouseCursor::UpDownResizeCursor);
     }
     
     ~EditableTextBoxSlider()
     {
-        const auto params = audioProcessor.getParameters();
-        for (auto param : params){
-            param->removeListener(this);
-        }
+        instance->removeListener(this);
     }
     
     void paint(juce::Graphics& g) override {}
@@ -51,9 +46,8 @@ public:
         auto bounds = getLocalBounds();
         textBox.setBounds(bounds);
         
-        auto value = audioProcessor.params->apvts.getRawParameterValue(parameterID)->load();
-        juce::String formattedValue = formatValueWithUnit(value);
-        textBox.setText(formattedValue, juce::dontSendNotification);
+        auto value = parameter->convertFrom0to1(parameter->getValue());
+        showValue(value, true);
     }
         
     void mouseDown(const juce::MouseEvent& m) override
@@ -61,7 +55,7 @@ public:
         auto mousePoint = m.getPosition().toFloat();
         dragStartPoint.y = mousePoint.y;
         
-        initialParamValue = audioProcessor.params->apvts.getParameter(parameterID)->getValue();
+        initialParamValue = parameter->getValue();
     }
 
     void mouseDrag(const juce::MouseEvent& m) override
@@ -93,7 +87,7 @@ public:
         auto value = l->getText().getFloatValue();
         float valueLimited = juce::jlimit(rangeStart, rangeEnd, value);
         
-        l->setText(formatValueWithUnit(valueLimited), juce::dontSendNotification);
+        showValue(valueLimited, true);
         textBox.setInterceptsMouseClicks(false, false);
         
         float normalized = (valueLimited - rangeStart) / (rangeEnd - rangeStart);
@@ -109,47 +103,23 @@ public:
     void textValueToParamValue(float value)
     {
         value = juce::jlimit(0.0f, 1.0f, value);
-        audioProcessor.params->apvts.getParameter(parameterID)->setValueNotifyingHost(value);
+        parameter->setValueNotifyingHost(value);
     }
         
-    void parameterValueChanged (int parameterIndex, float newValue) override
+    void safeValueChanged(float newValue) override
     {
-        const juce::SpinLock::ScopedLockType lock(pendingLock);
-        pendingChanges.emplace_back(parameterIndex, newValue);
-        triggerAsyncUpdate();
+        showValue(newValue, false);
     }
     
-    void parameterGestureChanged (int parameterIndex, bool gestureIsStarting) override {}
-    
-    void handleAsyncUpdate() override
+    void showValue(float value, bool force)
     {
-        std::vector<std::pair<int, float>> updatesCopy;
-
-        {
-            const juce::SpinLock::ScopedLockType lock(pendingLock);
-            updatesCopy.swap(pendingChanges); // safely move all pending updates
-        }
-
-        for (const auto& [parameterIndex, newValue] : updatesCopy)
-        {
-            juce::String newParameterID;
-            float scaledValue;
-            
-            if (auto* param = dynamic_cast<juce::AudioProcessorParameterWithID*>(audioProcessor.getParameters()[parameterIndex]))
-            {
-                if (auto* rangedParam = dynamic_cast<juce::RangedAudioParameter*>(param))
-                {
-                    scaledValue = rangedParam->convertFrom0to1(newValue);
-                    newParameterID = param->paramID;
-                }
-            }
-            
-            if (newParameterID == parameterID)
-            {
-                juce::String formattedValue = formatValueWithUnit(scaledValue);
-                textBox.setText(formattedValue, juce::dontSendNotification);
-            }
-        }
+        // skip the string and the repaint while the visible digits stay the same
+        const auto key = ParameterRegistry::getDisplayKey(parameterIndex, value);
+        if (!force && key == displayedKey)
+            return;
+        
+        displayedKey = key;
+        textBox.setText(formatValueWithUnit(value), juce::dontSendNotification);
     }
 
     void setFontSize(float size)
@@ -157,11 +127,6 @@ public:
         textBox.setFont(juce::FontOptions(size, juce::Font::plain));
     }
     
-    void setNumDecimals(int numDecimals)
-    {
-        this->numDecimals = numDecimals;
-    }
-    
     void setSuffix(juce::String parameterSuffix)
     {
         this->parameterSuffix = parameterSuffix;
@@ -172,68 +137,25 @@ public:
         textBox.setJustificationType(justification);
     }
     
-    void timerCallback() override
-    {
-        auto bounds = getLocalBounds().toFloat();
-        auto mouse = getMouseXYRelative().toFloat();
-        if (bounds.contains(mouse))
-        {
-            setMouseCursor(juce::MouseCursor::UpDownResizeCursor);
-        }
-    }
-    
-    void setUnitStyle(UnitStyle style)
-    {
-        unitStyle = style; // Store the style for use in formatting
-    }
-    
+    // units and decimals come from the parameter's registry entry
     juce::String formatValueWithUnit(float value)
     {
-        switch(unitStyle)
-        {
-            case UnitStyle::Int:
-                return juce::String((int)std::round(value));
-                        
-            case UnitStyle::Hertz:
-            {
-                if (value >= 1000.0f)
-                {
-                    return juce::String(value / 1000.0f, numDecimals) + " kHz";
-                }
-                else
-                {
-                    return juce::String(value, numDecimals) + " Hz";
-                }
-            }
-                            
-            case UnitStyle::Percent:
-                return juce::String(value, numDecimals) + " %";
-                
-            case UnitStyle::Sync:
-            {
-                auto syncRateOptions = audioProcessor.params->getSyncRateOptions();
-                auto formatted = syncRateOptions[std::floor(value)];
-                return juce::String(formatted);
-            }
-                
-            default:
-                return juce::String(value, numDecimals);
-        }
+        return ParameterRegistry::format(parameterIndex, value);
     }
 
     
 private:
-    UnitStyle unitStyle = UnitStyle::Float;
     float initialParamValue;
     float rangeStart, rangeEnd;
     
-    std::vector<std::pair<int, float>> pendingChanges;
-    juce::SpinLock pendingLock;
+    int64_t displayedKey = 0;
 
     juce::Point<float> dragStartPoint;
     juce::Label textBox;
-    int numDecimals = 1;
-    juce::String parameterID, parameterSuffix = "";
+    int parameterIndex;
+    juce::RangedAudioParameter* parameter;
+    ParameterInstance* instance;
+    juce::String parameterSuffix = "";
     
     TingeAudioProcessor& audioProcessor;
 };
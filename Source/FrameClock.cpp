@@ -0,0 +1,90 @@
+/*
+  ==============================================================================
+
+    FrameClock.cpp
+
+  ==============================================================================
+*/
+
+#include "FrameClock.h"
+
+FrameClock::FrameClock(juce::Component& host) : host(host) {}
+
+FrameClock::~FrameClock()
+{
+    stopTimer();
+    vblank = {};
+}
+
+void FrameClock::wake(Client& client)
+{
+    awake.addIfNotAlreadyThere(&client);
+    stopTimer();
+
+    if (!running)
+    {
+        vblank = juce::VBlankAttachment { &host, [this] { tick(); } };
+        running = true;
+    }
+}
+
+void FrameClock::remove(Client& client)
+{
+    awake.removeFirstMatchingValue(&client);
+
+    if (wakeClient == &client)
+    {
+        wakeClient = nullptr;
+        wakeCheck = nullptr;
+    }
+}
+
+void FrameClock::invalidate(juce::Component& component)
+{
+    if (component.isShowing())
+        dirty.add(host.getLocalArea(&component, component.getLocalBounds()));
+}
+
+void FrameClock::setWakeCheck(Client& client, std::function<bool()> check)
+{
+    wakeClient = &client;
+    wakeCheck = std::move(check);
+}
+
+void FrameClock::tick()
+{
+    // a hidden or minimised editor has nothing to show, everything sleeps until
+    // the wake check sees it on screen again with something new
+    if (!host.isShowing())
+        awake.clear();
+    
+    // backwards, so clients woken during the frame start on the next one
+    for (int i = awake.size(); --i >= 0;)
+    {
+        if (!awake.getUnchecked(i)->advanceFrame())
+            awake.remove(i);
+    }
+
+    dirty.consolidate();
+    for (const auto& area : dirty)
+        host.repaint(area);
+    dirty.clear();
+
+    // the attachment can't be released from inside its own callback, the idle timer does it
+    if (awake.isEmpty() && !isTimerRunning())
+        startTimerHz(idleCheckHz);
+}
+
+void FrameClock::timerCallback()
+{
+    if (awake.isEmpty() && running)
+    {
+        vblank = {};
+        running = false;
+    }
+
+    if (wakeCheck == nullptr)
+        stopTimer();
+    else if (wakeCheck())
+        wake(*wakeClient);
+}
@@ -0,0 +1,56 @@
+/*
+  ==============================================================================
+
+    FrameClock.h
+
+  ==============================================================================
+*/
+
+#pragma once
+#include <JuceHeader.h>
+
+// the editor's only animation clock. clients tick on the display's vblank while
+// they are awake, their repaints are merged into one pass per frame, and once
+// every client sleeps the vblank is dropped and a slow check decides when to wake
+class FrameClock : private juce::Timer
+{
+public:
+    struct Client
+    {
+        virtual ~Client() = default;
+
+        // once per frame while awake, false once there is nothing left to animate
+        virtual bool advanceFrame() = 0;
+    };
+
+    explicit FrameClock(juce::Component& host);
+    ~FrameClock() override;
+
+    // ticks the client from the next frame on
+    void wake(Client& client);
+    void remove(Client& client);
+
+    // repaint through the clock, overlapping areas are painted once
+    void invalidate(juce::Component& component);
+
+    // polled a few times a second while everything sleeps, true wakes the client
+    void setWakeCheck(Client& client, std::function<bool()> check);
+
+private:
+    void tick();
+    void timerCallback() override;
+
+    static constexpr int idleCheckHz = 10;
+
+    juce::Component& host;
+    juce::VBlankAttachment vblank;
+    bool running = false;
+
+    juce::Array<Client*> awake;
+    juce::RectangleList<int> dirty;
+
+    Client* wakeClient = nullptr;
+    std::function<bool()> wakeCheck;
+
+    JUCE_DECLARE_NON_COPYABLE (FrameClock)
+};
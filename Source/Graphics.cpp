@@ -1,94 +1,53 @@
 #include "Graphics.h"
 
-SpinnerGraphics::SpinnerGraphics()
+SpinnerGraphics::SpinnerGraphics(FrameClock& frameClock) : frameClock(frameClock)
 {
     numThresholds = 0;
 
     thresholdSlew.setSampleRate(60);
     thresholdSlew.setEnvelopeSlew(800, 800);
-    startTimerHz(60);
+}
+
+SpinnerGraphics::~SpinnerGraphics()
+{
+    frameClock.remove(*this);
 }
 
 void SpinnerGraphics::paint(juce::Graphics& g) 
 {
     setWheelPosition();
     
-    // summed wheel
-    auto sumA = createWheelPath(g,
-                                sumBounds,
-                                rotationValue[0].phase,
-                                rotationValue[0].phase + 0.5f);
-
-    auto sumB = createWheelPath(g,
-                                sumBounds,
-                                rotationValue[1].phase,
-                                rotationValue[1].phase + 0.5f);
+    // summed wheel, every sector shares one centre so the overlaps are plain sectors too
+    sumWheel.setBounds(sumBounds, isometricSkew);
     
-    auto sumC = createWheelPath(g,
-                                sumBounds,
-                                rotationValue[2].phase,
-                                rotationValue[2].phase + 0.5f);
-
-    auto sumABAngles = clipValues(rotationValue[0].phase,
-                                  fmodf(rotationValue[0].phase + 0.5f, 1.0f),
-                                  rotationValue[1].phase,
-                                  fmodf(rotationValue[1].phase + 0.5f, 1.0f));
+    std::array<SumWheel::Arc, editorSpinners> arcs;
+    for (int i = 0; i < editorSpinners; i++)
+        arcs[i] = SumWheel::toArc(rotationValue[i].phase, 0.5f);
     
-    auto sumBCAngles = clipValues(rotationValue[1].phase,
-                                  fmodf(rotationValue[1].phase + 0.5f, 1.0f),
-                                  rotationValue[2].phase,
-                                  fmodf(rotationValue[2].phase + 0.5f, 1.0f));
-
-    auto sumACAngles = clipValues(rotationValue[0].phase,
-                                  fmodf(rotationValue[0].phase + 0.5f, 1.0f),
-                                  rotationValue[2].phase,
-                                  fmodf(rotationValue[2].phase + 0.5f, 1.0f));
-
+    const auto abArc = SumWheel::intersect(arcs[0], arcs[1]);
+    const auto bcArc = SumWheel::intersect(arcs[1], arcs[2]);
+    const auto acArc = SumWheel::intersect(arcs[0], arcs[2]);
+    const auto abcArc = SumWheel::intersect(abArc, arcs[2]);
     
-    auto sumABCAngles = clipValues(rotationValue[0].phase,
-                                   fmodf(rotationValue[0].phase + 0.5f, 1.0f),
-                                   rotationValue[1].phase,
-                                   fmodf(rotationValue[1].phase + 0.5f, 1.0f),
-                                   rotationValue[2].phase,
-                                   fmodf(rotationValue[2].phase + 0.5f, 1.0f));
-
-    auto sumAB = createWheelPath(g,
-                                 sumBounds,
-                                 sumABAngles[0],
-                                 sumABAngles[1]);
-    
-    auto sumBC = createWheelPath(g,
-                                 sumBounds,
-                                 sumBCAngles[0],
-                                 sumBCAngles[1]);
-    
-    auto sumAC = createWheelPath(g,
-                                 sumBounds,
-                                 sumACAngles[0],
-                                 sumACAngles[1]);
-
-    auto sumABC = createWheelPath(g,
-                                 sumBounds,
-                                 sumABCAngles[0],
-                                 sumABCAngles[1]);
-
-
-    drawWithoutOverlap(g, sumA, colorA, false);
-    drawWithoutOverlap(g, sumB, colorB, false);
-    drawWithoutOverlap(g, sumC, colorC, false);
-    drawDoubleOverlap(g, sumA, sumB, colorAB, false);
-    drawDoubleOverlap(g, sumB, sumC, colorBC, false);
-    drawDoubleOverlap(g, sumA, sumC, colorAC, false);
-    drawTripleOverlap(g, sumA, sumB, sumC, colorABC, false);
+    drawWithoutOverlap(g, sumWheel.getSector(0, arcs[0]), colorA, false);
+    drawWithoutOverlap(g, sumWheel.getSector(1, arcs[1]), colorB, false);
+    drawWithoutOverlap(g, sumWheel.getSector(2, arcs[2]), colorC, false);
+    drawWithoutOverlap(g, sumWheel.getSector(sumAB, abArc), colorAB, false);
+    drawWithoutOverlap(g, sumWheel.getSector(sumBC, bcArc), colorBC, false);
+    drawWithoutOverlap(g, sumWheel.getSector(sumAC, acArc), colorAC, false);
+    drawWithoutOverlap(g, sumWheel.getSector(sumABC, abcArc), colorABC, false);
     
     
     drawThreshold(g);
     
     
     // single wheel
-    auto C = generateWheelPath(g, 2);
-    auto B = generateWheelPath(g, 1);
-    auto A = generateWheelPath(g, 0);
+    for (int i = 0; i < editorSpinners; i++)
+        wheels[i].setBounds(rotationValue[i].bounds, isometricSkew);
+    
+    const auto& A = wheels[0].getSector(0, arcs[0]);
+    const auto& B = wheels[1].getSector(0, arcs[1]);
+    const auto& C = wheels[2].getSector(0, arcs[2]);
     
     
     drawWithoutOverlap(g, A, p.colorA, false);
@@ -139,72 +98,6 @@ void SpinnerGraphics::setWheelPosition()
     sumBounds.setBounds(x + wheelMargin, y - sumYScale + sumYOffset, wheelWidth, wheelWidth);
 }
 
-juce::Path SpinnerGraphics::generateWheelPath(juce::Graphics& g, int index)
-{
-    float x = rotationValue[index].bounds.getX();
-    float y = rotationValue[index].bounds.getY();
-    float width = rotationValue[index].bounds.getWidth();
-    float height = rotationValue[index].bounds.getHeight();
-    
-    float twopi = juce::MathConstants<float>::twoPi;
-    float radius = width/2;
-    
-    juce::Path wheelPath;
-
-    float startAngle = rotationValue[index].phase * twopi;
-    float endAngle = (rotationValue[index].phase + 0.5f) * twopi;
-
-    if (endAngle <= startAngle)
-        endAngle += twopi;
-        
-        wheelPath.startNewSubPath(x + width/2, y + height/isometricSkew);
-        wheelPath.addCentredArc(x + width/2, y + height/isometricSkew,
-                                radius,
-                                radius/isometricSkew,
-                                0.0f,
-                                startAngle,
-                                endAngle);
-        wheelPath.closeSubPath();
-        wheelPath = wheelPath.createPathWithRoundedCorners(1);
-
-    return wheelPath;
-}
-
-juce::Path SpinnerGraphics::generateSegmentedWheelPath(juce::Graphics& g, int startIndex, int endIndex)
-{
-    float twopi = juce::MathConstants<float>::twoPi;
-    float x = rotationValue[startIndex].sumBounds.getX();
-    float y = rotationValue[startIndex].sumBounds.getY();
-    float width = rotationValue[startIndex].sumBounds.getWidth();
-    float height = rotationValue[startIndex].sumBounds.getHeight();
-    float radius = width/2;
-    
-    juce::Path wheelPath;
-
-    float startAngle  = rotationValue[startIndex].phase;
-    float clipStartAngle  = rotationValue[endIndex].phase;
-    float endAngle  = rotationValue[startIndex].phase + 0.5f;
-    float clipEndAngle  = rotationValue[endIndex].phase + 0.5f;
-
-    startAngle = std::max(startAngle, clipStartAngle);
-    endAngle = std::min(endAngle, clipEndAngle);
-    
-    startAngle *= twopi;
-    endAngle *= twopi;
-
-        wheelPath.startNewSubPath(x + width/2, y + height/isometricSkew); // center
-        wheelPath.addCentredArc(x + width/2, y + height/isometricSkew,
-                                radius, radius/isometricSkew,
-                                0.0f, startAngle, endAngle);
-        wheelPath.closeSubPath();
-        wheelPath = wheelPath.createPathWithRoundedCorners(1);
-
-    return wheelPath;
-}
-
-
-
-
 void SpinnerGraphics::drawThreshold(juce::Graphics& g)
 {
     float x = sumBounds.getX();
@@ -220,10 +113,7 @@ void SpinnerGraphics::drawThreshold(juce::Graphics& g)
     
     for (int i = 0; i < numThresholds; i++)
     {
-        float weightA = ((float)rotationValue[0].threshold[i] * rotationValue[0].opacity)/3.0f;
-        float weightB = ((float)rotationValue[1].threshold[i] * rotationValue[1].opacity)/3.0f;
-        float weightC = ((float)rotationValue[2].threshold[i] * rotationValue[2].opacity)/3.0f;
-        float thresholdWeight = (weightA + weightB + weightC);
+        float thresholdWeight = getThresholdWeight(i);
         
         
         thresholdSlew.triggerEnvelope(thresholdWeight);
@@ -252,9 +142,7 @@ void SpinnerGraphics::drawThreshold(juce::Graphics& g)
             graphicPath.closeSubPath();
             graphicPath = graphicPath.createPathWithRoundedCorners(3.0f);
             
-            bool triggerCondition = getTriggerCondition(i, overlapIndex);
-            
-            auto thresholdColor = triggerCondition ? Colors::graphicWhite : Colors::graphicBlack;
+            auto thresholdColor = ((triggerMask >> i) & 1) ? Colors::graphicWhite : Colors::graphicBlack;
 
             g.setColour(thresholdColor);
             g.fillPath(graphicPath);
@@ -271,8 +159,12 @@ void SpinnerGraphics::setThresholdSlew(float slewTime)
 
 void SpinnerGraphics::setOverlapIndex(int overlapIndex)
 {
+    if (overlapIndex == this->overlapIndex)
+        return;
+    
     this->overlapIndex = overlapIndex;
     setOverlapColours();
+    changed();
 }
 
 void SpinnerGraphics::setOverlapColours()
@@ -304,13 +196,44 @@ void SpinnerGraphics::setOverlapColours()
     }
 }
     
-void SpinnerGraphics::setParams(int index, float phase, float opacity1, float opacity2, float opacity3)
+bool SpinnerGraphics::setTelemetry(const TelemetrySnapshot& snapshot)
+{
+    // a running engine publishes every block, only a moved spinner or threshold repaints
+    bool isSame = numThresholds == snapshot.numThresholds && thresholdAngles == snapshot.thresholdAngles
+                  && triggerMask == snapshot.triggerMask;
+    for (int index = 0; index < editorSpinners; index++)
+    {
+        isSame = isSame && rotationValue[index].phase == snapshot.phases[index]
+                        && rotationValue[index].thresholdMask == snapshot.thresholdMasks[index];
+    }
+    
+    if (isSame)
+        return false;
+    
+    // the audio thread already placed the thresholds and tested them against the spinners
+    numThresholds = snapshot.numThresholds;
+    thresholdAngles = snapshot.thresholdAngles;
+    triggerMask = snapshot.triggerMask;
+    
+    for (int index = 0; index < editorSpinners; index++)
+    {
+        rotationValue[index].phase = snapshot.phases[index];
+        rotationValue[index].thresholdMask = snapshot.thresholdMasks[index];
+    }
+    changed();
+    return true;
+}
+
+void SpinnerGraphics::setOpacity(float opacity1, float opacity2, float opacity3)
 {
-    rotationValue[index].phase = phase;
-    p.setColors(opacity1/100.0f,
-                opacity2/100.0f,
-                opacity3/100.0f);
-    repaint();
+    if (!p.setColors(opacity1/100.0f,
+                     opacity2/100.0f,
+                     opacity3/100.0f))
+        return;
+    
+    // the summed wheel takes its overlap colours from the palette
+    setOverlapColours();
+    changed();
 }
 
 void SpinnerGraphics::setAnimation(float value)
@@ -324,7 +247,14 @@ void SpinnerGraphics::setAnimationValue(float animationValue)
     this->animationValue = animationValue;
 }
 
-void SpinnerGraphics::timerCallback()
+void SpinnerGraphics::changed()
+{
+    framesSinceChange = 0;
+    frameClock.wake(*this);
+}
+
+bool SpinnerGraphics::advanceFrame()
 {
-    repaint();
+    frameClock.invalidate(*this);
+    return ++framesSinceChange < settleFrames;
 }
@@ -1,21 +1,23 @@
 
 #pragma once
 #include "InteractionLogic.h"
+#include "Telemetry.h"
 #include "LookAndFeel.h"
 #include "DSP.h"
 #include "GraphicsHelper.h"
+#include "WheelGeometry.h"
+#include "FrameClock.h"
 
-class SpinnerGraphics : public juce::Component, public Interaction, public DrawHelper, public juce::Timer
+class SpinnerGraphics : public juce::Component, public Interaction<editorSpinners>, public DrawHelper, public FrameClock::Client
 {
 public:
-    SpinnerGraphics();
+    SpinnerGraphics(FrameClock& frameClock);
+    ~SpinnerGraphics() override;
     void paint(juce::Graphics& g) override;
     void resized() override;
     
     //  ==============================================================================
     void setWheelPosition();
-    juce::Path generateWheelPath(juce::Graphics& g, int index);
-    juce::Path generateSegmentedWheelPath(juce::Graphics& g, int startIndex, int endIndex);
     void drawThreshold(juce::Graphics& g);
     void setThresholdSlew(float slewTime);
     //==============================================================================
@@ -24,142 +26,36 @@ public:
     void setOverlapColours();
     //  ==============================================================================
 
-    void setParams(int index, float phase, float opacity1, float opacity2, float opacity3);
+    // true when a spinner or threshold moved
+    bool setTelemetry(const TelemetrySnapshot& snapshot);
+    void setOpacity(float opacity1, float opacity2, float opacity3);
     void setAnimation(float value);
     void setAnimationValue(float animationValue);
     
-    std::array<float, 2> clipValues(float startA, float endA, float startB, float endB, float startC, float endC)
-    {
-        std::array<float,2> clippedAB = clipValues(startA, endA, startB, endB);
-        float s = clippedAB[0];
-        float e = clippedAB[1];
-        if (s > e)
-            e -= 1.0f;
-
-        std::array<float,2> clippedABC = clipValues(clippedAB[0], clippedAB[1], startC, endC);
-        return clippedABC;
-
-    }
+private:
+    bool advanceFrame() override;
+    void changed();
     
-    /*
-    std::array<float, 2> clipValues(float startA, float endA, float startB, float endB)
-    {
-        std::array<float, 2> clipped = { 0.0f, 0.5f };
-        
-        bool wrapsA = startA > endA;
-        bool wrapsB = startB > endB;
+    // frames painted after the last change, long enough for the threshold slew to land
+    static constexpr int settleFrames = 60;
+    int framesSinceChange = 0;
+    FrameClock& frameClock;
 
-        if (!wrapsA && !wrapsB)
-        {
-            float s = std::max(startA, startB);
-            float e = std::min(endA, endB);
-            if (s < e)
-                clipped = { s, e };
-            
-        } else if (wrapsA && !wrapsB)
-        {
-            float s1 = std::max(startA, startB);
-            float e1 = std::min(1.0f,   endB);
-            if (s1 < e1)
-                clipped = { s1, e1 };
-
-            float s2 = std::max(0.0f, startB);
-            float e2 = std::min(endA, endB);
-            if (s2 < e2)
-                clipped = { s2, e2 };
-            
-        } else if (!wrapsA && wrapsB) {
-            float s1 = std::max(startA, startB);
-            float e1 = std::min(endA,   1.0f);
-            if (s1 < e1)
-                clipped = { s1, e1 };
-
-            float s2 = std::max(startA, 0.0f);
-            float e2 = std::min(endA,   endB);
-            if (s2 < e2)
-                clipped = { s2, e2 };
-            
-        } else {
-            float s = std::max(startA, startB);
-            float e = std::min(endA, endB);
-            if (s > e)
-                e += 1.0f;
-            
-            clipped = { s, e };
-            
-        }
-        return clipped;
-    }
-    */
+    // one slot per spinner, then the pairs and the triple on the summed wheel
+    enum SumSector { sumAB = editorSpinners, sumBC, sumAC, sumABC, numSumSectors };
     
-    std::array<float, 2> clipValues(float startA, float endA, float startB, float endB)
-    {
-        std::array<float, 2> clipped = { 0.0f, 0.0f };
-
-        auto normalize = [](float v) {
-            if (v < 0.0f) return v + 1.0f;
-            if (v >= 1.0f) return v - 1.0f;
-            return v;
-        };
-
-        // Handle wrap-around by mapping everything to [0,2) range
-        float sA = startA;
-        float eA = (endA < startA) ? endA + 1.0f : endA;
-        float sB = startB;
-        float eB = (endB < startB) ? endB + 1.0f : endB;
-
-        // Intersection
-        float s = std::max(sA, sB);
-        float e = std::min(eA, eB);
-
-        if (s < e) {
-            clipped[0] = normalize(s);
-            clipped[1] = normalize(e);
-        } else {
-            // No overlap, return empty interval
-            clipped[0] = clipped[1] = 0.0f;
-        }
-
-        return clipped;
-    }
-
+    using Wheel = WheelGeometry<1>;
+    using SumWheel = WheelGeometry<numSumSectors>;
     
-    juce::Path createWheelPath(juce::Graphics &g, juce::Rectangle<float> bounds, float startAngle, float endAngle)
-    {
-        
-        float x = bounds.getX();
-        float y = bounds.getY();
-        float width = bounds.getWidth();
-        float height = bounds.getHeight();
-
-        juce::Path wheelPath;
-        float radius = width/2;
-        float twopi = juce::MathConstants<float>::twoPi;
-
-        wheelPath.startNewSubPath(x + width/2, y + height/(isometricSkew)); // center
-        wheelPath.addCentredArc(x + width/2,
-                                y + height/(isometricSkew),
-                                radius,
-                                radius/(isometricSkew),
-                                0.0f,
-                                startAngle * twopi,
-                                endAngle * twopi);
-        
-        wheelPath.closeSubPath();
-        wheelPath = wheelPath.createPathWithRoundedCorners(1);
-
-    return wheelPath;
-    }
+    std::array<Wheel, editorSpinners> wheels;
+    SumWheel sumWheel;
     
-
-private:
-    void timerCallback() override;
-
     LowPassGate thresholdSlew;
     juce::Rectangle<float> sumBounds;
     juce::Colour colorA, colorB, colorC, colorAB, colorBC, colorAC, colorABC;
     
-    int overlapIndex;
+    int overlapIndex = -1;
+    uint16_t triggerMask = 0; // thresholds the engine triggers for its overlap mode
     float animationValue;
     float isometricSkew;
     float isometricOffset;
@@ -169,7 +65,7 @@ private:
 };
 
 /*
-class MeterGraphics : public juce::Component, public Interaction, public DrawHelper, public juce::Timer
+class MeterGraphics : public juce::Component, public Interaction<editorSpinners>, public DrawHelper, public juce::Timer
 {
 public:
     MeterGraphics()
@@ -221,10 +117,7 @@ public:
         if (meterWriteIndex > 127) { meterWriteIndex = 0; }
         
         for (int i = 0; i < numThresholds; i++){
-            float weightA = ((float)rotationValue[0].threshold[i] * rotationValue[0].opacity)/3.0f;
-            float weightB = ((float)rotationValue[1].threshold[i] * rotationValue[1].opacity)/3.0f;
-            float weightC = ((float)rotationValue[2].threshold[i] * rotationValue[2].opacity)/3.0f;
-            float thresholdWeight = (weightA + weightB + weightC);
+            float thresholdWeight = getThresholdWeight(i);
             measurement[i][meterWriteIndex] = thresholdWeight;
         }
     }
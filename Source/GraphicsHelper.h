@@ -90,7 +90,7 @@ class DrawHelper
 {
 public:
     
-    void drawWithoutOverlap(juce::Graphics& g, juce::Path& path, juce::Colour color, bool strokePath)
+    void drawWithoutOverlap(juce::Graphics& g, const juce::Path& path, juce::Colour color, bool strokePath)
     {
         g.setColour(color);
         g.fillPath(path);
@@ -100,7 +100,7 @@ public:
         }
     }
 
-    void drawDoubleOverlap(juce::Graphics& g, juce::Path& pathA, juce::Path& pathB, juce::Colour color, bool strokePath)
+    void drawDoubleOverlap(juce::Graphics& g, const juce::Path& pathA, const juce::Path& pathB, juce::Colour color, bool strokePath)
     {
         g.saveState();
         g.reduceClipRegion(pathA);
@@ -114,7 +114,7 @@ public:
         g.restoreState();
     }
 
-    void drawTripleOverlap(juce::Graphics& g, juce::Path& pathA, juce::Path& pathB, juce::Path& pathC, juce::Colour color, bool strokePath)
+    void drawTripleOverlap(juce::Graphics& g, const juce::Path& pathA, const juce::Path& pathB, const juce::Path& pathC, juce::Colour color, bool strokePath)
     {
         g.saveState();
         g.reduceClipRegion(pathA);
@@ -129,7 +129,7 @@ public:
         g.restoreState();
     }
     
-    void drawQuadrupleOverlap(juce::Graphics& g, juce::Path& pathA, juce::Path& pathB, juce::Path& pathC, juce::Path& pathD, juce::Colour color, bool strokePath)
+    void drawQuadrupleOverlap(juce::Graphics& g, const juce::Path& pathA, const juce::Path& pathB, const juce::Path& pathC, const juce::Path& pathD, juce::Colour color, bool strokePath)
     {
         g.saveState();
         g.reduceClipRegion(pathA);
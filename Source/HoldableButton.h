@@ -12,38 +12,43 @@
 #include "JuceHeader.h"
 #include "PluginProcessor.h"
 #include "DSP.h"
+#include "FrameClock.h"
 
 enum class HoldableButtonLAF { NudgeForward, NudgeBackward, Brake };
 
-class GlobalHoldableButton : public juce::Button, public juce::Timer
+class GlobalHoldableButton : public juce::Button, public FrameClock::Client
 {
 public:
-    GlobalHoldableButton(TingeAudioProcessor& p, HoldableButtonLAF l)
-    : juce::Button("HoldableButton"), lookAndFeel(l), audioProcessor(p)
+    GlobalHoldableButton(TingeAudioProcessor& p, FrameClock& c, HoldableButtonLAF l)
+    : juce::Button("HoldableButton"), frameClock(c), lookAndFeel(l), audioProcessor(p)
     {
         slew.setSampleRate(60);
         slew.setEnvelopeSlew(240, 240);
-        startTimerHz(60);
         
         switch(lookAndFeel){
             case HoldableButtonLAF::NudgeForward:
             {
-                parameterID = "nudgeForward";
+                parameter = audioProcessor.params->getParameter(ParameterRegistry::nudgeForward);
                 break;
             }
             case HoldableButtonLAF::NudgeBackward:
             {
-                parameterID = "nudgeBackward";
+                parameter = audioProcessor.params->getParameter(ParameterRegistry::nudgeBackward);
                 break;
             }
             case HoldableButtonLAF::Brake:
             {
-                parameterID = "brake";
+                parameter = audioProcessor.params->getParameter(ParameterRegistry::brake);
                 break;
             }
         }
     }
     
+    ~GlobalHoldableButton() override
+    {
+        frameClock.remove(*this);
+    }
+    
     void paintButton(juce::Graphics& g, bool shouldDrawButtonAsHighlighted, bool shouldDrawButtonAsDown) override
     {
         auto bounds = getLocalBounds().toFloat();
@@ -120,15 +125,17 @@ public:
     void mouseDown(const juce::MouseEvent& e) override
     {
         buttonState = true;
-            if (auto* param = audioProcessor.params->apvts.getParameter(parameterID))
-                param->setValueNotifyingHost(1.0f);
+        if (parameter != nullptr)
+            parameter->setValueNotifyingHost(1.0f);
+        frameClock.wake(*this);
     }
     
     void mouseUp(const juce::MouseEvent& e) override
     {
         buttonState = false;
-        if (auto* param = audioProcessor.params->apvts.getParameter(parameterID))
-            param->setValueNotifyingHost(0.0f);
+        if (parameter != nullptr)
+            parameter->setValueNotifyingHost(0.0f);
+        frameClock.wake(*this);
     }
     
     float getButtonState()
@@ -137,16 +144,18 @@ public:
     }
     
 private:
-    void timerCallback() override
+    bool advanceFrame() override
     {
         slew.triggerEnvelope(getButtonState());
         lpgValue = slew.generateEnvelope();
-        repaint();
+        frameClock.invalidate(*this);
+        return !slew.isSettled();
     }
     
-    
-    juce::String parameterID;
-    bool buttonState;
+    FrameClock& frameClock;
+
+    juce::RangedAudioParameter* parameter = nullptr;
+    bool buttonState = false;
     LowPassGate slew;
     float lpgValue = 0.0f;
     
@@ -1,7 +1,9 @@
 
 #pragma once
 #include <JuceHeader.h>
+#include "Config.h"
 
+template <int NumSpinners>
 class Interaction 
 {
 public:
@@ -11,21 +13,17 @@ public:
         randomSeed = rand.nextInt();
     }
     
-    std::array<bool, 16> getInteraction(float startPhase, float shape, std::array<float, 16> &thresholdAngles)
+    uint16_t getInteraction(float startPhase, float shape, const std::array<float, 16> &thresholdAngles)
     {
-        std::array<bool, 16> thresholdBool;
-        for (int i = 0; i < thresholdBool.size(); i++){
-            thresholdBool[i] = false;
-        }
-
+        const float endPhase = fmodf(startPhase + shape, 1.0f);
+        uint16_t thresholdMask = 0;
+        
         for (int j = 0; j < numThresholds; j++) {
-            bool overThreshold = isOverThreshold(thresholdAngles[j],
-                                                 startPhase,
-                                                 fmodf(startPhase + shape, 1.0f));
-            if (overThreshold) { thresholdBool[j] = true; }
+            if (isOverThreshold(thresholdAngles[j], startPhase, endPhase))
+                thresholdMask |= (uint16_t)(1u << j);
         }
         
-        return thresholdBool;
+        return thresholdMask;
     }
     
     bool isOverThreshold(float value, float start, float end) {
@@ -40,11 +38,112 @@ public:
     
     void processThreshold(thresholdMode mode, float thresholdPhase, int maxThreshold)
     {
-        thresholdPhase = thresholdPhase/100.0f;
-        
         if (numThresholds == 0)
             return;
         
+        // the angles only move when one of their inputs does
+        if (mode != cachedMode || thresholdPhase != cachedThresholdPhase
+            || maxThreshold != cachedMaxThreshold || numThresholds != cachedNumThresholds)
+        {
+            cachedMode = mode;
+            cachedThresholdPhase = thresholdPhase;
+            cachedMaxThreshold = maxThreshold;
+            cachedNumThresholds = numThresholds;
+            
+            updateThresholdAngles(mode, thresholdPhase/100.0f, maxThreshold);
+        }
+        
+        // find the interaction of thresholds
+        for (int index = 0; index < NumSpinners; index++)
+        {
+            rotationValue[index].thresholdMask = getInteraction(rotationValue[index].phase, rotationValue[index].shape, thresholdAngles);
+            
+        }
+    }
+
+    void setNumThresholds(std::array<float, 16> heldNotes)
+    {
+        int thresCounter = 0;
+        for (int i = 0; i < 16; i++){
+            thresholdValues[i].noteNumber = heldNotes[i];
+            
+            if (thresholdValues[i].noteNumber != -1)
+            {
+                thresCounter++;
+            }
+        }
+        numThresholds = thresCounter;
+    }
+
+    // thresholds that trigger for the overlap mode, one bit per threshold
+    uint16_t getTriggerMask(int overlap) const
+    {
+        // count the spinners over each threshold bitwise, saturating at two
+        uint32_t atLeastOne = 0, atLeastTwo = 0, all = 0xffff;
+        for (int index = 0; index < NumSpinners; index++)
+        {
+            const uint32_t mask = rotationValue[index].opacity >= 0.01f ? rotationValue[index].thresholdMask : 0;
+            atLeastTwo |= atLeastOne & mask;
+            atLeastOne |= mask;
+            all &= mask;
+        }
+        
+        const uint32_t single = atLeastOne & ~atLeastTwo;
+        const uint32_t partial = atLeastTwo & ~all;
+        const uint32_t full = all;
+        
+        const uint8_t classes = overlapClasses[juce::isPositiveAndBelow(overlap, (int)overlapClasses.size()) ? overlap : 6];
+        return (uint16_t)(((classes & singleClass) ? single : 0)
+                        | ((classes & partialClass) ? partial : 0)
+                        | ((classes & fullClass) ? full : 0));
+    }
+    
+    float getThresholdWeight(int i) const
+    {
+        float thresholdWeight = 0.0f;
+        for (int index = 0; index < NumSpinners; index++)
+            thresholdWeight += ((float)rotationValue[index].isOver(i) * rotationValue[index].opacity)/(float)NumSpinners;
+        
+        return thresholdWeight;
+    }
+
+    // eventually three of these per rotation
+    int numThresholds = 0, prevNumThresholds = 0;
+    
+    std::array<float, 32> angles;
+    
+    struct RotationValue
+    {
+        float phase = 0.0f;
+        float shape = 0.5f;
+        float opacity = 0.8f;
+        uint16_t thresholdMask = 0; // bit per threshold inside the spinner window
+        
+        bool isOver(int i) const { return (thresholdMask >> i) & 1; }
+        
+        //******* Graphics Code *******//
+        juce::Rectangle<float> sumBounds;
+        juce::Rectangle<float> bounds;
+        
+    };
+    
+    std::array<RotationValue, NumSpinners> rotationValue;
+
+    struct Threshold
+    {
+        float anglePosition;
+        bool threshold;
+        int noteNumber;
+    };
+    
+    std::array<Threshold, 16> thresholdValues;
+    std::array<float, 16> thresholdAngles;
+
+    
+private:
+    
+    void updateThresholdAngles(thresholdMode mode, float thresholdPhase, int maxThreshold)
+    {
         switch(mode){
             case thresholdMode::EquiDistant:
             {
@@ -106,89 +205,21 @@ public:
                 break;
             }
         }
-        
-        // find the interaction of thresholds
-        for (int index = 0; index < 3; index++)
-        {
-            rotationValue[index].threshold = getInteraction(rotationValue[index].phase, rotationValue[index].shape, thresholdAngles);
-            
-        }
-    }
-
-    void setNumThresholds(std::array<float, 16> heldNotes)
-    {
-        int thresCounter = 0;
-        for (int i = 0; i < 16; i++){
-            thresholdValues[i].noteNumber = heldNotes[i];
-            
-            if (thresholdValues[i].noteNumber != -1)
-            {
-                thresCounter++;
-            }
-        }
-        numThresholds = thresCounter;
-    }
-
-    bool getTriggerCondition(int i, int overlap)
-    {
-        bool A = rotationValue[0].threshold[i] && rotationValue[0].opacity >= 0.01f;
-        bool B = rotationValue[1].threshold[i] && rotationValue[1].opacity >= 0.01f;
-        bool C = rotationValue[2].threshold[i] && rotationValue[2].opacity >= 0.01f;
-        
-        bool onlyA  =  A && !B && !C;
-        bool onlyB  = !A &&  B && !C;
-        bool onlyC  = !A && !B &&  C;
-        bool onlyAB =  A &&  B && !C;
-        bool onlyBC = !A &&  B &&  C;
-        bool onlyAC =  A && !B &&  C;
-        bool allABC = A && B && C;
-        
-        switch (overlap)
-        {
-            case 0: return onlyA || onlyB || onlyC;
-            case 1: return onlyAB || onlyBC || onlyAC;
-            case 2: return allABC;
-            case 3: return onlyA || onlyB || onlyC || onlyAB || onlyBC || onlyAC;
-            case 4: return onlyA || onlyB || onlyC || allABC;
-            case 5: return onlyAB || onlyBC || onlyAC || allABC;
-            case 6: return A || B || C; 
-            default: return A || B || C;
-        }
     }
-
-    // eventually three of these per rotation
-    int numThresholds = 0, prevNumThresholds = 0;
-    
-    std::array<float, 32> angles;
-    
-    struct RotationValue
-    {
-        float phase = 0.0f;
-        float shape = 0.5f;
-        float opacity = 0.8f;
-        std::array<bool, 16> threshold;
-        
-        //******* Graphics Code *******//
-        juce::Rectangle<float> sumBounds;
-        juce::Rectangle<float> bounds;
-        
-    };
     
-    std::array<RotationValue, 3> rotationValue;
-
-    struct Threshold
-    {
-        float anglePosition;
-        bool threshold;
-        int noteNumber;
+    // overlap modes 0-6 as sets of spinner counts over a threshold: exactly one,
+    // more than one but not all, or all of them
+    enum { singleClass = 1, partialClass = 2, fullClass = 4 };
+    static constexpr std::array<uint8_t, 7> overlapClasses = {
+        singleClass,
+        partialClass,
+        fullClass,
+        singleClass | partialClass,
+        singleClass | fullClass,
+        partialClass | fullClass,
+        singleClass | partialClass | fullClass
     };
     
-    std::array<Threshold, 16> thresholdValues;
-    std::array<float, 16> thresholdAngles;
-
-    
-private:
-    
     void sigmoid(float slope)
     {
         for (int i = 0; i < numThresholds; i++)
@@ -207,6 +238,10 @@ private:
     }
     
     int randomSeed;
+    
+    int cachedMode = -1, cachedMaxThreshold = -1, cachedNumThresholds = -1;
+    float cachedThresholdPhase = 0.0f;
+    
     std::array<double, 16> fibonacci = {
         0.000000,  // 1 -> 0
         0.000000,  // 1 -> 0
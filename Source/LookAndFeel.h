@@ -84,13 +84,19 @@ struct Palette
     }
 
      
-    void setColors(float alphaA, float alphaB, float alphaC)
+    // returns false when the opacities are the ones already mixed
+    bool setColors(float alphaA, float alphaB, float alphaC)
     {
         
         alphaA = juce::jlimit(0.0f, 1.0f, alphaA);
         alphaB = juce::jlimit(0.0f, 1.0f, alphaB);
         alphaC = juce::jlimit(0.0f, 1.0f, alphaC);
         
+        if (alphaA == lastAlpha[0] && alphaB == lastAlpha[1] && alphaC == lastAlpha[2])
+            return false;
+        
+        lastAlpha = { alphaA, alphaB, alphaC };
+
 
         colorA = interpolateColors(Colors::backgroundFill, Colors::primaryColor[0], alphaA);
         colorB = interpolateColors(Colors::backgroundFill, Colors::primaryColor[1], alphaB);
@@ -101,7 +107,7 @@ struct Palette
         colorAC = darkenColors(colorA, colorC);
 
         colorABC = darkenColors(colorA, colorB, colorC);
-
+        return true;
     }
     juce::Colour colorA;
     juce::Colour colorB;
@@ -110,5 +116,8 @@ struct Palette
     juce::Colour colorBC;
     juce::Colour colorAC;
     juce::Colour colorABC;
+
+private:
+    std::array<float, 3> lastAlpha { -1.0f, -1.0f, -1.0f };
 };
 
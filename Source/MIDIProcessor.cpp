@@ -1,9 +1,11 @@
 
 #include "MIDIProcessor.h"
 
-void MIDIProcessor::prepareToPlay(double sampleRate)
+template <int NumSpinners>
+void MIDIProcessor<NumSpinners>::prepareToPlay(double sampleRate)
 {
     this->sampleRate = sampleRate;
+    reserveOutput();
     
         for (int i = 0; i < noteValue.size(); i++)
     {
@@ -12,9 +14,13 @@ void MIDIProcessor::prepareToPlay(double sampleRate)
     }
 }
 
-void MIDIProcessor::holdPitches(juce::MidiBuffer &buffer)
+template <int NumSpinners>
+void MIDIProcessor<NumSpinners>::holdPitches(const juce::MidiBuffer &buffer, const ParameterEvents& parameterEvents)
 {
-    juce::MidiBuffer filteredBuffer;
+    // filter into the buffer reserved in prepareToPlay, the notes played later
+    // in the block go on after it and the host only gets it in handOver
+    juce::MidiBuffer& filteredBuffer = outputBuffer;
+    filteredBuffer.clear();
     
     if (!hold)
     {
@@ -38,7 +44,7 @@ void MIDIProcessor::holdPitches(juce::MidiBuffer &buffer)
     for (const auto metadata : buffer)
     {
         const auto message = metadata.getMessage();
-        bool addToBuffer = true;
+        bool addToBuffer = !parameterEvents.consumes(message);
         if (message.isNoteOn())
         {
             for (auto& note : noteValue)
@@ -79,10 +85,25 @@ void MIDIProcessor::holdPitches(juce::MidiBuffer &buffer)
             filteredBuffer.addEvent(message, metadata.samplePosition);
         }
     }
-    buffer.swapWith(filteredBuffer);
 }
 
-void MIDIProcessor::setHold(juce::MidiBuffer &buffer, bool guiHold)
+template <int NumSpinners>
+void MIDIProcessor<NumSpinners>::handOver(juce::MidiBuffer& destination) const
+{
+    destination.clear();
+    destination.addEvents(outputBuffer, 0, -1, 0);
+}
+
+template <int NumSpinners>
+void MIDIProcessor<NumSpinners>::reserveOutput()
+{
+    // message thread, the audio thread only ever clears it
+    outputBuffer.clear();
+    outputBuffer.ensureSize(reservedOutputBytes);
+}
+
+template <int NumSpinners>
+void MIDIProcessor<NumSpinners>::setHold(const juce::MidiBuffer &buffer, bool guiHold)
 {
     for (const auto metadata : buffer)
     {
@@ -97,7 +118,8 @@ void MIDIProcessor::setHold(juce::MidiBuffer &buffer, bool guiHold)
 }
 
 
-std::array<float, 16> MIDIProcessor::getheldPitches()
+template <int NumSpinners>
+std::array<float, 16> MIDIProcessor<NumSpinners>::getheldPitches()
 {
     std::array<float, 16> heldPitches = {};
     for (int i = 0; i < heldPitches.size(); i++)
@@ -107,7 +129,8 @@ std::array<float, 16> MIDIProcessor::getheldPitches()
     return heldPitches;
 }
 
-int MIDIProcessor::getNumHeldNotes()
+template <int NumSpinners>
+int MIDIProcessor<NumSpinners>::getNumHeldNotes()
 {
     int noteCount = 0;
     for(int i = 0; i < 16; i++)
@@ -121,23 +144,28 @@ int MIDIProcessor::getNumHeldNotes()
 }
 
 
-void MIDIProcessor::noteOn(juce::MidiBuffer& midiBuffer, int channel, int samplePosition, int noteNumber, int noteVelocity)
+template <int NumSpinners>
+void MIDIProcessor<NumSpinners>::noteOn(juce::MidiBuffer& midiBuffer, int channel, int samplePosition, int noteNumber, int noteVelocity)
 {
     juce::MidiMessage noteOn = juce::MidiMessage::noteOn(channel, noteNumber, uint8_t(noteVelocity));
     midiBuffer.addEvent(noteOn, samplePosition);
 }
 
-void MIDIProcessor::noteOff(juce::MidiBuffer& midiBuffer, int channel, int samplePosition, int noteNumber)
+template <int NumSpinners>
+void MIDIProcessor<NumSpinners>::noteOff(juce::MidiBuffer& midiBuffer, int channel, int samplePosition, int noteNumber)
 {
     noteNumber = juce::jlimit(0, 127, noteNumber);
     juce::MidiMessage noteOff = juce::MidiMessage::noteOff(channel, noteNumber);
     midiBuffer.addEvent(noteOff, samplePosition);
 }
 
+template class MIDIProcessor<numSpinners>;
+
 
 void Spinner::prepareToPlay(double sampleRate, int samplesPerBlock)
 {
     this->sampleRate = sampleRate;
+    this->inverseSampleRate = 1.0 / sampleRate;
     this->samplesPerBlock = samplesPerBlock;
     forwardLPG.setSampleRate(sampleRate);
     backwardLPG.setSampleRate(sampleRate);
@@ -225,33 +253,104 @@ void Spinner::nudge(int nudgeForward, int nudgeBackward, int brake, float jog)
 
 void Spinner::accumulate()
 {
-    float nudgeValue = (forwardLPG.generateEnvelope() + (backwardLPG.generateEnvelope() * -1.0f)) * 10.0f;
-    float brakeValue = (1.0f - brakeLPG.generateEnvelope());
+    accumulate(forwardLPG.generateEnvelope(),
+               backwardLPG.generateEnvelope(),
+               brakeLPG.generateEnvelope());
+}
+
+void Spinner::accumulate(float forwardEnvelope, float backwardEnvelope, float brakeEnvelope)
+{
+    float nudgeValue = (forwardEnvelope + (backwardEnvelope * -1.0f)) * 10.0f;
+    float brakeValue = (1.0f - brakeEnvelope);
     
     if (!holdAccum){
-        if (!rateMode) // sync
-        {            
-            float bpmInHz = ((bpm/60.0f) * rateSyncOptions[rateSync]) + nudgeValue;
-            phase += (bpmInHz/sampleRate) * brakeValue;
-            
-        } else {
-            float rateInHz = rateFree + nudgeValue;
-            phase += (rateInHz/sampleRate) * brakeValue;
-            
+        double increment = getIncrement(nudgeValue, brakeValue);
+        phase += increment;
+        segmentTravel += increment;
+    }
+    
+    if (phase >= 1.0f) phase -= 1.0f;
+    previousPhase = phase;
+}
+
+void Spinner::advance(int numSamples)
+{
+    // step per sample only while a nudge or brake envelope is still moving
+    int sample = 0;
+    while (sample < numSamples && !isIdle())
+    {
+        const int blockSize = std::min(numSamples - sample, envelopeBlockSize);
+        forwardLPG.generateEnvelope(forwardEnvelope.data(), blockSize);
+        backwardLPG.generateEnvelope(backwardEnvelope.data(), blockSize);
+        brakeLPG.generateEnvelope(brakeEnvelope.data(), blockSize);
+        
+        for (int i = 0; i < blockSize; ++i){
+            accumulate(forwardEnvelope[i], backwardEnvelope[i], brakeEnvelope[i]);
         }
+        sample += blockSize;
     }
     
-    if (phase >= 1.0f) phase = 0.0f;
+    const int remainingSamples = numSamples - sample;
+    if (remainingSamples <= 0 || holdAccum)
+        return;
+    
+    // settled envelopes give the same increment every sample, jump straight to the end
+    float nudgeValue = (forwardLPG.getEnvelope() + (backwardLPG.getEnvelope() * -1.0f)) * 10.0f;
+    float brakeValue = (1.0f - brakeLPG.getEnvelope());
+    
+    double travel = getIncrement(nudgeValue, brakeValue) * remainingSamples;
+    phase += travel;
+    segmentTravel += travel;
+    
+    if (phase >= 1.0f) phase -= std::floor(phase);
     previousPhase = phase;
 }
 
+bool Spinner::isIdle() const
+{
+    return forwardLPG.isSettled() && backwardLPG.isSettled() && brakeLPG.isSettled();
+}
+
+float Spinner::getBaseRate() const
+{
+    if (!rateMode) // sync
+        return (float)((bpm/60.0f) * rateSyncOptions[rateSync]);
+    
+    return rateFree;
+}
+
+double Spinner::getIncrement(float nudgeValue, float brakeValue) const
+{
+    // SpinnerBank::processSamples repeats this arithmetic lane by lane, keep them in step
+    float rateInHz = getBaseRate() + nudgeValue;
+    return (rateInHz * inverseSampleRate) * brakeValue;
+}
+
+void Spinner::beginSegment()
+{
+    segmentStartPhase = getLinearPhase();
+    segmentTravel = 0.0;
+}
+
+CrossingEngine::Segment Spinner::getSegment(int numSamples)
+{
+    // the crossing engine treats the motion over the segment as linear
+    CrossingEngine::Segment segment;
+    segment.startPhase = segmentStartPhase;
+    segment.increment = numSamples > 0 ? segmentTravel / numSamples : 0.0;
+    segment.curve = curve;
+    return segment;
+}
+
 float Spinner::getPhase()
+{
+    return getCurvedPhase(getLinearPhase());
+}
+
+float Spinner::getLinearPhase()
 {
     float offset = fmodf(phase + phaseOffset/100.0f, 1.0f);
-    float phaseOutput = getWrappedPhase(offset);
-    phaseOutput = getCurvedPhase(phaseOutput);
-    
-    return phaseOutput;
+    return getWrappedPhase(offset);
 }
 
 float Spinner::getCurvedPhase(float phase)
@@ -279,3 +378,12 @@ bool Spinner::getDirection()
 {
     return phase >= previousPhase;
 }
+
+bool Spinner::matches(const Spinner& other) const
+{
+    return phase == other.phase
+        && segmentTravel == other.segmentTravel
+        && forwardLPG.getEnvelope() == other.forwardLPG.getEnvelope()
+        && backwardLPG.getEnvelope() == other.backwardLPG.getEnvelope()
+        && brakeLPG.getEnvelope() == other.brakeLPG.getEnvelope();
+}
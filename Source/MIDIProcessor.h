@@ -12,15 +12,37 @@
 #include <JuceHeader.h>
 #include "DSP.h"
 #include "InteractionLogic.h"
+#include "CrossingEngine.h"
+#include "Telemetry.h"
+#include "ParameterEvents.h"
 
-class MIDIProcessor : public Interaction
+template <int NumSpinners>
+class MIDIProcessor : public Interaction<NumSpinners>
 {
 public:
+    // note on/off, CC74 and aftertouch per threshold at the block start and at
+    // every crossing, the held and flushed note offs, plus whatever the host passes through
+    static constexpr int maxOutputEvents = 4 * (16 + CrossingEngine::maxCrossings) + 2 * 16 + 256;
+    static constexpr size_t reservedOutputBytes = maxOutputEvents * (sizeof(int32_t) + sizeof(uint16_t) + 3);
+    
+    using Interaction<NumSpinners>::rotationValue;
+    using Interaction<NumSpinners>::numThresholds;
+    using Interaction<NumSpinners>::thresholdAngles;
+    using Interaction<NumSpinners>::getTriggerMask;
+    using Interaction<NumSpinners>::getThresholdWeight;
+    using Interaction<NumSpinners>::setNumThresholds;
+    using Interaction<NumSpinners>::processThreshold;
+    
     void prepareToPlay(double sampleRate);
-    void holdPitches(juce::MidiBuffer &m);
+    void holdPitches(const juce::MidiBuffer &m, const ParameterEvents& parameterEvents);
     int nextAvailableIndex = 0;
     
-    void setHold(juce::MidiBuffer &m, bool hold);
+    void setHold(const juce::MidiBuffer &m, bool hold);
+    
+    // the block's output, filtered input first and then every generated event
+    juce::MidiBuffer& getOutput() { return outputBuffer; }
+    // copies the finished block into the host's buffer
+    void handOver(juce::MidiBuffer& destination) const;
     
     std::array<float, 16> getheldPitches();
     int getNumHeldNotes();
@@ -31,7 +53,7 @@ public:
     void processInteraction(int thresholdMode, float thresholdPhase, float maxThreshold)
     {
         setNumThresholds(getheldPitches());
-        processThreshold(static_cast<enum thresholdMode>(thresholdMode),
+        processThreshold(static_cast<typename Interaction<NumSpinners>::thresholdMode>(thresholdMode),
                          thresholdPhase,
                          maxThreshold);
 
@@ -50,71 +72,137 @@ public:
         return a + (b - a) * t;
     }
     
-    void notePlayback(juce::MidiBuffer& midiBuffer)
+    void notePlayback(juce::MidiBuffer& midiBuffer, int samplePosition)
     {
         if (numThresholds <= 0)
-            flushNote(midiBuffer); // figure out how to trigger this one
+            flushNote(midiBuffer, samplePosition); // figure out how to trigger this one
         
+        const uint16_t triggerMask = getTriggerMask(overlap);
         for (int i = 0; i < numThresholds; i++)
         {
-            const bool triggerCondition = getTriggerCondition(i, overlap);
-            
-            float weightA = ((float)rotationValue[0].threshold[i] * rotationValue[0].opacity)/3.0f;
-            float weightB = ((float)rotationValue[1].threshold[i] * rotationValue[1].opacity)/3.0f;
-            float weightC = ((float)rotationValue[2].threshold[i] * rotationValue[2].opacity)/3.0f;
-            float thresholdWeight = weightA + weightB + weightC;
-            
-            const int currentNote = juce::jlimit(0, 127, noteValue[i].noteNumber);
-            
-            int velocityScaled = (127 * thresholdWeight);
-            const int currentVelocity = juce::jlimit(0, 127, velocityScaled);
-            
-            int controllerScaled = (127 * thresholdWeight);
-            int currentController = juce::jlimit(0, 127, controllerScaled);
-            currentController = (int)slewValue(currentController, prevController, slewAmount);
+            playThreshold(midiBuffer, i, samplePosition, (triggerMask >> i) & 1);
+        }
+    }
+    
+    void processCrossings(juce::MidiBuffer& midiBuffer, int startSample, int numSamples)
+    {
+        crossingEngine.clear();
+        for (int index = 0; index < NumSpinners; index++)
+        {
+            crossingEngine.addSpinner(index,
+                                      segments[index],
+                                      rotationValue[index].shape,
+                                      thresholdAngles,
+                                      numThresholds,
+                                      startSample,
+                                      numSamples);
+        }
+        crossingEngine.sort();
+        
+        int i = 0;
+        while (i < crossingEngine.size())
+        {
+            // settle every edge landing on this sample before playing the thresholds
+            const int samplePosition = crossingEngine[i].samplePosition;
+            uint32_t changedThresholds = 0;
             
-            int mpeChannel = i + 1;
+            for (; i < crossingEngine.size() && crossingEngine[i].samplePosition == samplePosition; i++)
+            {
+                const auto& crossing = crossingEngine[i];
+                const uint16_t bit = (uint16_t)(1u << crossing.threshold);
+                auto& thresholdMask = rotationValue[crossing.spinner].thresholdMask;
+                
+                thresholdMask = (uint16_t)(crossing.isInside ? (thresholdMask | bit) : (thresholdMask & ~bit));
+                changedThresholds |= bit;
+            }
             
-            if (triggerCondition)
+            playChangedThresholds(midiBuffer, changedThresholds, samplePosition);
+        }
+    }
+    
+    // interaction again at a segment start inside the block, only thresholds
+    // whose spinners moved in or out of them are played
+    void updateInteraction(juce::MidiBuffer& midiBuffer, int samplePosition, int thresholdMode, float thresholdPhase, float maxThreshold)
+    {
+        std::array<uint16_t, NumSpinners> previousMasks;
+        for (int index = 0; index < NumSpinners; index++)
+            previousMasks[index] = rotationValue[index].thresholdMask;
+        
+        processThreshold(static_cast<typename Interaction<NumSpinners>::thresholdMode>(thresholdMode),
+                         thresholdPhase,
+                         maxThreshold);
+        
+        uint32_t changedThresholds = 0;
+        for (int index = 0; index < NumSpinners; index++)
+            changedThresholds |= previousMasks[index] ^ rotationValue[index].thresholdMask;
+        
+        playChangedThresholds(midiBuffer, changedThresholds, samplePosition);
+    }
+    
+    void playChangedThresholds(juce::MidiBuffer& midiBuffer, uint32_t changedThresholds, int samplePosition)
+    {
+        const uint16_t triggerMask = getTriggerMask(overlap);
+        for (int threshold = 0; threshold < numThresholds; threshold++)
+        {
+            if ((changedThresholds >> threshold) & 1)
+                playThreshold(midiBuffer, threshold, samplePosition, (triggerMask >> threshold) & 1);
+        }
+    }
+    
+    void playThreshold(juce::MidiBuffer& midiBuffer, int i, int samplePosition, bool triggerCondition)
+    {
+        float thresholdWeight = getThresholdWeight(i);
+        
+        const int currentNote = juce::jlimit(0, 127, noteValue[i].noteNumber);
+        
+        int velocityScaled = (127 * thresholdWeight);
+        const int currentVelocity = juce::jlimit(0, 127, velocityScaled);
+        
+        int controllerScaled = (127 * thresholdWeight);
+        int currentController = juce::jlimit(0, 127, controllerScaled);
+        currentController = (int)slewValue(currentController, prevController, slewAmount);
+        
+        int mpeChannel = i + 1;
+        
+        if (triggerCondition)
+        {
+            if (!noteValue[i].isOn || noteValue[i].activeNoteNumber != currentNote)
             {
-                if (!noteValue[i].isOn || noteValue[i].activeNoteNumber != currentNote)
+                // note off message for previously different note on
+                if (noteValue[i].isOn && noteValue[i].activeNoteNumber != -1)
                 {
-                    // note off message for previously different note on
-                    if (noteValue[i].isOn && noteValue[i].activeNoteNumber != -1)
-                    {
-                        noteOff(midiBuffer, mpeChannel, 0, noteValue[i].activeNoteNumber);
-                    }
-                    
-                    noteOn(midiBuffer, mpeChannel, 0, currentNote, currentVelocity);
-                    noteValue[i].isOn = true;
-                    noteValue[i].activeNoteNumber = currentNote;
-                    
+                    noteOff(midiBuffer, mpeChannel, samplePosition, noteValue[i].activeNoteNumber);
                 }
                 
-                midiBuffer.addEvent(juce::MidiMessage::controllerEvent(mpeChannel, 74, currentController), 0);
-                midiBuffer.addEvent(juce::MidiMessage::aftertouchChange(mpeChannel, currentNote, currentController), 0);
+                noteOn(midiBuffer, mpeChannel, samplePosition, currentNote, currentVelocity);
+                noteValue[i].isOn = true;
+                noteValue[i].activeNoteNumber = currentNote;
                 
-                prevController = currentController;
             }
-            else
+            
+            midiBuffer.addEvent(juce::MidiMessage::controllerEvent(mpeChannel, 74, currentController), samplePosition);
+            midiBuffer.addEvent(juce::MidiMessage::aftertouchChange(mpeChannel, currentNote, currentController), samplePosition);
+            
+            prevController = currentController;
+        }
+        else
+        {
+            if (noteValue[i].isOn && noteValue[i].activeNoteNumber != -1)
             {
-                if (noteValue[i].isOn && noteValue[i].activeNoteNumber != -1)
-                {
-                    noteOff(midiBuffer, mpeChannel, 0, noteValue[i].activeNoteNumber);
-                    noteValue[i].isOn = false;
-                    noteValue[i].activeNoteNumber = -1;
-                }
+                noteOff(midiBuffer, mpeChannel, samplePosition, noteValue[i].activeNoteNumber);
+                noteValue[i].isOn = false;
+                noteValue[i].activeNoteNumber = -1;
             }
         }
     }
     
-    void flushNote(juce::MidiBuffer& midiBuffer)
+    void flushNote(juce::MidiBuffer& midiBuffer, int samplePosition)
     {
         for (int i = 0; i < 16; i++) {
             int noteNumber = noteValue[i].activeNoteNumber;
             int channel = i + 1;
             
-            noteOff(midiBuffer, channel, 0, noteNumber);
+            noteOff(midiBuffer, channel, samplePosition, noteNumber);
             noteValue[i].isOn = false;
             noteValue[i].isAvailable = true;
         }
@@ -127,6 +215,11 @@ public:
 
     }
     
+    void setSpinnerSegment(int index, CrossingEngine::Segment segment)
+    {
+        segments[index] = segment;
+    }
+    
     void setOverlap(int overlap)
     {
         this->overlap = overlap;
@@ -137,6 +230,25 @@ public:
         this->slewAmount = slewAmount/100.0f;
     }
     
+    void writeTelemetry(TelemetrySnapshot& snapshot) const
+    {
+        static_assert (NumSpinners <= numSpinners, "the snapshot holds numSpinners masks");
+        
+        snapshot.thresholdAngles = thresholdAngles;
+        snapshot.numThresholds = numThresholds;
+        snapshot.triggerMask = getTriggerMask(overlap);
+        
+        snapshot.noteOnMask = 0;
+        for (int i = 0; i < 16; i++)
+        {
+            if (noteValue[i].isOn)
+                snapshot.noteOnMask |= (uint16_t)(1u << i);
+        }
+        
+        for (int index = 0; index < NumSpinners; index++)
+            snapshot.thresholdMasks[index] = rotationValue[index].thresholdMask;
+    }
+    
 private:
     
     double sampleRate;
@@ -155,6 +267,12 @@ private:
     };
 
     std::array<NoteValue, 16> noteValue;
+    
+    juce::MidiBuffer outputBuffer;
+    void reserveOutput();
+    
+    CrossingEngine crossingEngine;
+    std::array<CrossingEngine::Segment, NumSpinners> segments;
 };
 
 
@@ -172,17 +290,33 @@ public:
     void nudge(int nudgeForward, int nudgeBackward, int brake, float jog);
 
     void accumulate();
+    void accumulate(float forwardEnvelope, float backwardEnvelope, float brakeEnvelope);
+    void advance(int numSamples);
+    bool isIdle() const;
+    void beginSegment();
+    CrossingEngine::Segment getSegment(int numSamples);
     float getPhase();
+    float getLinearPhase();
     float getCurvedPhase(float phase);
     float getWrappedPhase(float phase);
     bool getDirection();
+    bool matches(const Spinner& other) const;
     
     
 private:
+    template <int> friend class SpinnerBank;
+    
+    float getBaseRate() const;
+    double getIncrement(float nudgeValue, float brakeValue) const;
+    
     LowPassGate forwardLPG, backwardLPG, brakeLPG;
-    double sampleRate;
+    static constexpr int envelopeBlockSize = 32;
+    std::array<float, envelopeBlockSize> forwardEnvelope, backwardEnvelope, brakeEnvelope;
+    
+    double sampleRate, inverseSampleRate = 0.0;
     int samplesPerBlock;
     double phase = 0.0f, previousPhase = 0.0f;
+    double segmentStartPhase = 0.0, segmentTravel = 0.0;
     float phaseOffset = 0.0f, rateScale = 1.0f, curve = 1.0f;
     float bpm = 120.0f;
     
@@ -11,6 +11,18 @@
 #include "MiscControl.h"
 
 void GlobalControlsLookAndFeel::drawButtonBackground(juce::Graphics& g, juce::Button& button, const juce::Colour& backgroundColour, bool shouldDrawButtonAsHighlighted, bool shouldDrawButtonAsDown)
+{
+    // the slew value is the sprite value, the drawing reads it back from lpgValue
+    const float slewValue = lpgValue;
+    sprites.draw(g, button.getLocalBounds(), 0, slewValue, button.getToggleState(), [&] (juce::Graphics& sprite, float value)
+    {
+        lpgValue = value;
+        renderButton(sprite, button);
+    });
+    lpgValue = slewValue;
+}
+
+void GlobalControlsLookAndFeel::renderButton(juce::Graphics& g, juce::Button& button)
 {
     auto bounds = button.getLocalBounds().toFloat();
     bounds.reduce(5, 5);
@@ -52,7 +64,8 @@ void GlobalControlsLookAndFeel::drawButtonBackground(juce::Graphics& g, juce::Bu
 
 void GlobalControlsLookAndFeel::drawRotarySlider(juce::Graphics &g, int x, int y, int width, int height, float sliderPosProportional, float rotaryStartAngle, float rotaryEndAngle, juce::Slider &slider)
 {
-    drawJog(g, x, y, width, sliderPosProportional);
+    sprites.draw(g, slider.getLocalBounds(), 0, sliderPosProportional, 0,
+                 [&] (juce::Graphics& sprite, float position) { drawJog(sprite, x, y, width, position); });
 }
 
 
@@ -216,18 +229,18 @@ void GlobalControlsLookAndFeel::setLPGValue(float lpgValue)
 
 
 
-GlobalControlsLayout::GlobalControlsLayout(TingeAudioProcessor &p) : audioProcessor(p)
+GlobalControlsLayout::GlobalControlsLayout(TingeAudioProcessor &p, FrameClock& frameClock) : frameClock(frameClock), audioProcessor(p)
 {
     // nudge
     setLabel(*this, nudgeLabel, "Nudge", Colors::graphicBlack, juce::Justification::centred);
-    nudgeForwardButton = std::make_unique<GlobalHoldableButton>(audioProcessor, HoldableButtonLAF::NudgeForward);
+    nudgeForwardButton = std::make_unique<GlobalHoldableButton>(audioProcessor, frameClock, HoldableButtonLAF::NudgeForward);
     addAndMakeVisible(*nudgeForwardButton);
     
-    nudgeBackwardButton = std::make_unique<GlobalHoldableButton>(audioProcessor, HoldableButtonLAF::NudgeBackward);
+    nudgeBackwardButton = std::make_unique<GlobalHoldableButton>(audioProcessor, frameClock, HoldableButtonLAF::NudgeBackward);
     addAndMakeVisible(*nudgeBackwardButton);
 
     setLabel(*this, brakeLabel, "Brake", Colors::graphicBlack, juce::Justification::centred);
-    brakeButton = std::make_unique<GlobalHoldableButton>(audioProcessor, HoldableButtonLAF::Brake);
+    brakeButton = std::make_unique<GlobalHoldableButton>(audioProcessor, frameClock, HoldableButtonLAF::Brake);
     addAndMakeVisible(*brakeButton);
 
     // jog
@@ -251,13 +264,11 @@ GlobalControlsLayout::GlobalControlsLayout(TingeAudioProcessor &p) : audioProces
     // set up slew values
     resetSlew.setSampleRate(60);
     resetSlew.setEnvelopeSlew(240, 240);
-
-    // set up timer
-    startTimerHz(60);
 }
 
 GlobalControlsLayout::~GlobalControlsLayout()
 {
+    frameClock.remove(*this);
     resetButton.removeListener(this);
 }
 
@@ -340,7 +351,7 @@ void GlobalControlsLayout::buttonClicked(juce::Button* b)
     {
         bool currentHoldValue = (bool)audioProcessor.params->hold->get();
         bool hold = !currentHoldValue;
-        audioProcessor.params->apvts.getParameter("hold")->setValueNotifyingHost(hold);
+        audioProcessor.params->getParameter(ParameterRegistry::hold)->setValueNotifyingHost(hold);
     }
 }
 
@@ -356,14 +367,15 @@ void GlobalControlsLayout::buttonStateChanged(juce::Button* b)
     {
         float reset = b->isDown() ? 1.0f : 0.0f;
         resetSlew.triggerEnvelope(b->isDown());
-        audioProcessor.params->apvts.getParameter("reset")->setValueNotifyingHost(reset);
-        
+        audioProcessor.params->getParameter(ParameterRegistry::reset)->setValueNotifyingHost(reset);
+        frameClock.wake(*this);
     }
 }
 
-void GlobalControlsLayout::timerCallback()
+bool GlobalControlsLayout::advanceFrame()
 {
     float reset = resetSlew.generateEnvelope();
     resetLAF.setLPGValue(reset);
-    resetButton.repaint();
+    frameClock.invalidate(resetButton);
+    return !resetSlew.isSettled();
 }
@@ -14,6 +14,8 @@
 #include "LookAndFeel.h"
 #include "GraphicsHelper.h"
 #include "HoldableButton.h"
+#include "FrameClock.h"
+#include "SpriteCache.h"
 
 enum class GlobalControlsLAF { NudgeForward, NudgeBackward, Brake, Jog, Hold, Reset};
 
@@ -36,15 +38,20 @@ public:
     void setLPGValue(float lpgValue);
 
 public:
-    float lpgValue;
+    float lpgValue = 0.0f;
     GlobalControlsLAF lookAndFeel;
+
+private:
+    void renderButton(juce::Graphics& g, juce::Button& button);
+    
+    SpriteCache sprites;
 };
 
 
-class GlobalControlsLayout : public juce::Component, juce::Button::Listener, juce::Timer, GraphicsHelper
+class GlobalControlsLayout : public juce::Component, juce::Button::Listener, FrameClock::Client, GraphicsHelper
 {
 public:
-    GlobalControlsLayout(TingeAudioProcessor &p);
+    GlobalControlsLayout(TingeAudioProcessor &p, FrameClock& frameClock);
     ~GlobalControlsLayout();
     //==============================================================================
 
@@ -54,8 +61,9 @@ public:
     void buttonStateChanged(juce::Button* b) override;
 
 private:
-    void timerCallback() override;
+    bool advanceFrame() override;
 
+    FrameClock& frameClock;
     LowPassGate resetSlew;
     
     GlobalControlsLookAndFeel
@@ -11,6 +11,7 @@
 #pragma once
 #include <JuceHeader.h>
 #include "LookAndFeel.h"
+#include "SpriteCache.h"
 
 enum class MiscLAF { Overlap, SpinnerTab, ThresholdTab };
 class MiscLookAndFeel : public juce::LookAndFeel_V4, DrawHelper
@@ -27,7 +28,10 @@ public:
             {
                 float position = sliderPosProportional * 6;
                 position = std::floor(position);
-                drawOverlapSlider(g, x, y, width, position);
+                
+                // only seven states, the index is the variant rather than a quantised value
+                sprites.draw(g, slider.getLocalBounds(), 0, 0.0f, (int)position,
+                             [&] (juce::Graphics& sprite, float) { drawOverlapSlider(sprite, x, y, width, position); });
                 break;
             }
             case MiscLAF::SpinnerTab: { break; }
@@ -44,19 +48,22 @@ public:
         float iconSize = bounds.getHeight();
 
         
-        switch(lookAndFeel){
-            case MiscLAF::Overlap: { break; }
-            case MiscLAF::SpinnerTab:
-            {
-                drawSpinnerTab(g, (x + width/2) - (iconSize/2), y, iconSize);
-                break;
-            }
-            case MiscLAF::ThresholdTab:
-            {
-                drawThresholdTab(g, (x + width/2) - (iconSize/2), y, iconSize);
-                break;
+        sprites.draw(g, button.getLocalBounds(), 0, 0.0f, 0, [&] (juce::Graphics& sprite, float)
+        {
+            switch(lookAndFeel){
+                case MiscLAF::Overlap: { break; }
+                case MiscLAF::SpinnerTab:
+                {
+                    drawSpinnerTab(sprite, (x + width/2) - (iconSize/2), y, iconSize);
+                    break;
+                }
+                case MiscLAF::ThresholdTab:
+                {
+                    drawThresholdTab(sprite, (x + width/2) - (iconSize/2), y, iconSize);
+                    break;
+                }
             }
-        }
+        });
     }
      
     void prepareColors(bool hover)
@@ -171,5 +178,6 @@ private:
     juce::Colour colorA, colorB, colorC, colorAB, colorBC, colorAC, colorABC;
     
     MiscLAF lookAndFeel;
+    SpriteCache sprites;
     Palette p;
 };
@@ -0,0 +1,129 @@
+/*
+  ==============================================================================
+
+    ParameterEvents.cpp
+
+  ==============================================================================
+*/
+
+#include "ParameterEvents.h"
+
+bool ParameterEvents::isHandled(const juce::MidiMessage& message)
+{
+    return message.isController()
+        && message.getControllerNumber() >= nudgeForwardCC
+        && message.getControllerNumber() < rateSyncCC + numRateSyncCCs;
+}
+
+void ParameterEvents::releaseControl()
+{
+    // switching CC Control off mustn't leave a switch held or a rate taken over
+    switches.fill(false);
+    rateSyncOverride.fill(false);
+}
+
+void ParameterEvents::collect(const juce::MidiBuffer& buffer, int numSamples, bool isEnabled)
+{
+    numEvents = 0;
+    nextEvent = 0;
+    blockSize = numSamples;
+    enabled = isEnabled;
+
+    if (!enabled)
+    {
+        releaseControl();
+        return;
+    }
+
+    // the last sub block keeps the minimum size too
+    const int lastPosition = juce::jmax(0, numSamples - minSubBlockSize);
+    int boundary = 0;
+
+    for (const auto metadata : buffer)
+    {
+        const auto message = metadata.getMessage();
+
+        if (!isHandled(message))
+            continue;
+
+        int position = juce::jlimit(0, lastPosition, metadata.samplePosition);
+        if (position - boundary < minSubBlockSize)
+            position = boundary;
+        else
+            boundary = position;
+
+        const Event event { position, message.getControllerNumber(), message.getControllerValue() };
+
+        // a controller moving twice inside one sub block only keeps its last value
+        bool merged = false;
+        for (int i = numEvents - 1; i >= 0 && events[i].position == position; i--)
+        {
+            if (events[i].controller == event.controller)
+            {
+                events[i].value = event.value;
+                merged = true;
+                break;
+            }
+        }
+
+        if (merged)
+            continue;
+
+        jassert(numEvents < maxEvents);
+        if (numEvents < maxEvents)
+            events[numEvents++] = event;
+    }
+}
+
+bool ParameterEvents::apply(int position)
+{
+    bool changed = false;
+
+    while (nextEvent < numEvents && events[nextEvent].position <= position)
+    {
+        const auto& event = events[nextEvent++];
+
+        if (event.controller < rateSyncCC)
+        {
+            switches[event.controller - nudgeForwardCC] = event.value >= 64;
+        }
+        else
+        {
+            const int index = event.controller - rateSyncCC;
+            rateSync[index] = juce::roundToInt(event.value * (numRateSyncChoices - 1) / 127.0f);
+            rateSyncOverride[index] = true;
+        }
+
+        changed = true;
+    }
+
+    return changed;
+}
+
+int ParameterEvents::getNextBoundary(int position) const
+{
+    for (int i = nextEvent; i < numEvents; i++)
+    {
+        if (events[i].position > position)
+            return events[i].position;
+    }
+    return blockSize;
+}
+
+bool ParameterEvents::getSwitch(int controller, bool parameterValue) const
+{
+    jassert(controller >= nudgeForwardCC && controller < rateSyncCC);
+    return parameterValue || switches[controller - nudgeForwardCC];
+}
+
+int ParameterEvents::getRateSync(int index, int parameterValue)
+{
+    // touching the parameter hands control back to it
+    if (parameterValue != lastParameterRateSync[index])
+    {
+        lastParameterRateSync[index] = parameterValue;
+        rateSyncOverride[index] = false;
+    }
+
+    return rateSyncOverride[index] ? rateSync[index] : parameterValue;
+}
@@ -0,0 +1,77 @@
+/*
+  ==============================================================================
+
+    ParameterEvents.h
+
+  ==============================================================================
+*/
+
+#pragma once
+#include <JuceHeader.h>
+#include "Config.h"
+#include "ParameterRegistry.h"
+
+// timestamped changes for the transport style parameters. hosts that automate
+// sample accurately route them in as MIDI CCs, processBlock then starts a new
+// sub block at every change instead of applying it at the block start. only
+// while the CC Control parameter is on, the CCs it handles are then consumed
+class ParameterEvents
+{
+public:
+    enum Controller
+    {
+        nudgeForwardCC = 20,
+        nudgeBackwardCC,
+        brakeCC,
+        resetCC,
+        rateSyncCC // one per spinner from here, up to the 14 bit LSB range at 32
+    };
+
+    // spinners past this one have no rate CC
+    static constexpr int numRateSyncCCs = juce::jmin(numSpinners, 32 - rateSyncCC);
+
+    // changes closer together than this share a sub block, the later one is
+    // applied early so a dense automation lane can't shrink the sub blocks
+    static constexpr int minSubBlockSize = 16;
+
+    // once per block, before any sub block is rendered
+    void collect(const juce::MidiBuffer& buffer, int numSamples, bool isEnabled);
+
+    // true for the CCs collected this block, they don't pass through
+    bool consumes(const juce::MidiMessage& message) const { return enabled && isHandled(message); }
+
+    // applies every change up to position, true when anything changed
+    bool apply(int position);
+
+    // where the sub block starting at position has to end
+    int getNextBoundary(int position) const;
+
+    // the CC switches are or'ed with the parameter, like the sustain pedal and hold
+    bool getSwitch(int controller, bool parameterValue) const;
+
+    // the latest of the CC and the parameter wins
+    int getRateSync(int index, int parameterValue);
+
+private:
+    struct Event
+    {
+        int position;
+        int controller;
+        int value;
+    };
+
+    static constexpr int numSwitches = 4;
+    static constexpr int numRateSyncChoices = (int)std::size(ParameterRegistry::rateSyncChoices);
+    static constexpr int maxEvents = 256;
+
+    static bool isHandled(const juce::MidiMessage& message);
+    void releaseControl();
+
+    std::array<Event, maxEvents> events;
+    int numEvents = 0, nextEvent = 0, blockSize = 0;
+    bool enabled = false;
+
+    std::array<bool, numSwitches> switches {};
+    std::array<int, numSpinners> rateSync {}, lastParameterRateSync {};
+    std::array<bool, numSpinners> rateSyncOverride {};
+};
@@ -0,0 +1,212 @@
+/*
+  ==============================================================================
+
+    ParameterRegistry.h
+
+  ==============================================================================
+*/
+
+#pragma once
+#include <JuceHeader.h>
+#include "Config.h"
+
+enum class UnitStyle { Int, Float, Percent, Hertz, Sync };
+
+// every parameter the plugin has, in the order they are added to the apvts.
+// a flat index into this table is also the parameter's index in the processor,
+// so the audio and message threads can look parameters up without strings
+namespace ParameterRegistry
+{
+    enum Kind
+    {
+        // global
+        nudgeForward,
+        nudgeBackward,
+        brake,
+        jog,
+        reset,
+        resetMode,
+        hold,
+        overlap,
+        valueSlew,
+        thresholdMode,
+        thresholdPhase,
+        maxThreshold,
+        ccControl,
+
+        // one per spinner
+        rateFree,
+        rateSync,
+        rateMode,
+        phase,
+        opacity,
+        curve,
+
+        numKinds
+    };
+
+    enum class Type { Int, Float, Bool, Choice };
+
+    struct Spec
+    {
+        const char* id;     // per spinner ids get the spinner index appended
+        const char* name;   // per spinner names get the spinner number appended
+        Type type;
+        float start, end, interval, defaultValue;
+        UnitStyle unit;
+        int numDecimals;
+        bool spreadDefault = false; // per spinner defaults spread evenly from 0 to end
+        const char* const* choices = nullptr;
+        int numChoices = 0;
+        int version = 1; // the release that added it, for hosts that key parameters by it
+    };
+
+    inline constexpr const char* resetModeChoices[] = { "Manual Reset", "Hold & Reset on Clear", "Hold on Clear" };
+    inline constexpr const char* thresholdModeChoices[] = { "EquiDistant", "Fill", "Harmonic", "Clusters", "Sequential", "Fibonacci" };
+    inline constexpr const char* rateSyncChoices[] = {
+        // negative values
+        "-1/32", "-1/24", "-1/16",
+        "-1/12", "-1/8", "-1/6", "-3/16",
+        "-1/4", "-5/16", "-1/3", "-3/8",
+        "-1/2", "-3/4", "-1",  "-2",
+        "-3", "-4", "-6", "-8",
+
+        // no motion
+        "No Motion",
+
+        // positive values
+        "8", "6", "4", "3",
+        "2", "1", "3/4", "1/2",
+        "3/8", "1/3", "5/16", "1/4",
+        "3/16", "1/6", "1/8", "1/12",
+        "1/16", "1/24", "1/32"
+    };
+
+    template <size_t N>
+    constexpr Spec choice(const char* id, const char* name, const char* const (&choices)[N], int defaultIndex)
+    {
+        return { id, name, Type::Choice, 0.0f, (float)(N - 1), 1.0f, (float)defaultIndex, UnitStyle::Sync, 0, false, choices, (int)N };
+    }
+
+    inline constexpr std::array<Spec, numKinds> specs = {{
+        { "nudgeForward",   "Nudge Forward",   Type::Int,   0.0f,    1.0f,   1.0f,   0.0f,   UnitStyle::Int,     0 },
+        { "nudgeBackward",  "Nudge Backward",  Type::Int,   0.0f,    1.0f,   1.0f,   0.0f,   UnitStyle::Int,     0 },
+        { "brake",          "Brake",           Type::Int,   0.0f,    1.0f,   1.0f,   0.0f,   UnitStyle::Int,     0 },
+        { "jog",            "Jog",             Type::Float, 0.0f,    100.0f, 0.1f,   100.0f, UnitStyle::Float,   1 },
+        { "reset",          "Reset",           Type::Bool,  0.0f,    1.0f,   1.0f,   0.0f,   UnitStyle::Int,     0 },
+        choice("resetMode", "Reset Mode", resetModeChoices, 0),
+        { "hold",           "Hold",            Type::Int,   0.0f,    1.0f,   1.0f,   0.0f,   UnitStyle::Int,     0 },
+        { "overlap",        "Overlap",         Type::Int,   0.0f,    6.0f,   1.0f,   6.0f,   UnitStyle::Int,     0 },
+        { "valueSlew",      "Value Slew",      Type::Float, 0.0f,    100.0f, 0.1f,   20.0f,  UnitStyle::Float,   1 },
+        choice("thresholdMode", "Threshold Mode", thresholdModeChoices, 0),
+        { "thresholdPhase", "Threshold Phase", Type::Float, 0.0f,    100.0f, 0.1f,   50.0f,  UnitStyle::Percent, 1 },
+        { "maxThreshold",   "Max Threshold",   Type::Int,   1.0f,    16.0f,  1.0f,   8.0f,   UnitStyle::Int,     0 },
+        { "ccControl",      "CC Control",      Type::Bool,  0.0f,    1.0f,   1.0f,   0.0f,   UnitStyle::Int,     0, false, nullptr, 0, 2 },
+
+        { "rateFree",       "RateFree",        Type::Float, -8.0f,   8.0f,   0.01f,  0.0f,   UnitStyle::Hertz,   2 },
+        choice("rateSync", "Rate Sync ", rateSyncChoices, 22),
+        { "rateMode",       "Rate Mode ",      Type::Bool,  0.0f,    1.0f,   1.0f,   0.0f,   UnitStyle::Int,     0 },
+        { "phase",          "Phase ",          Type::Float, -100.0f, 100.0f, 0.01f,  0.0f,   UnitStyle::Percent, 1, true },
+        { "opacity",        "Opacity ",        Type::Float, 0.0f,    100.0f, 0.1f,   80.0f,  UnitStyle::Percent, 1 },
+        { "curve",          "Curve ",          Type::Float, 50.0f,   200.0f, 0.01f,  100.0f, UnitStyle::Percent, 1 }
+    }};
+
+    constexpr int numGlobal = rateFree;
+    constexpr int numPerSpinner = numKinds - rateFree;
+    constexpr int numParameters = numGlobal + numPerSpinner * numSpinners;
+
+    constexpr int indexOf(Kind kind, int spinner = 0)
+    {
+        return kind < numGlobal ? (int)kind : numGlobal + spinner * numPerSpinner + (kind - numGlobal);
+    }
+
+    constexpr Kind kindOf(int index)
+    {
+        return index < numGlobal ? (Kind)index : (Kind)(numGlobal + (index - numGlobal) % numPerSpinner);
+    }
+
+    constexpr int spinnerOf(int index)
+    {
+        return index < numGlobal ? 0 : (index - numGlobal) / numPerSpinner;
+    }
+
+    constexpr const Spec& getSpec(int index)
+    {
+        return specs[(size_t)kindOf(index)];
+    }
+
+    static_assert (indexOf(curve, numSpinners - 1) == numParameters - 1, "per spinner parameters must close the table");
+    static_assert (kindOf(indexOf(phase, numSpinners - 1)) == phase && spinnerOf(indexOf(phase, numSpinners - 1)) == numSpinners - 1, "index and kind must round trip");
+
+    constexpr float getDefault(int index)
+    {
+        const auto& spec = getSpec(index);
+        if (!spec.spreadDefault)
+            return spec.defaultValue;
+
+        // floored, the phases spread the spinners evenly around the wheel
+        return (float)(int)(spec.end * spinnerOf(index) / numSpinners);
+    }
+
+    inline juce::String getID(int index)
+    {
+        const auto& spec = getSpec(index);
+        return index < numGlobal ? juce::String(spec.id) : juce::String(spec.id) + juce::String(spinnerOf(index));
+    }
+
+    inline juce::String getName(int index)
+    {
+        const auto& spec = getSpec(index);
+        return index < numGlobal ? juce::String(spec.name) : juce::String(spec.name) + juce::String(spinnerOf(index) + 1);
+    }
+
+    inline juce::StringArray getChoices(const Spec& spec)
+    {
+        return juce::StringArray(spec.choices, spec.numChoices);
+    }
+
+    // values with the same key format to the same text, so displays can skip
+    // formatting and repainting while a parameter moves below their precision
+    inline int64_t getDisplayKey(int index, float value)
+    {
+        const auto& spec = getSpec(index);
+
+        switch (spec.unit)
+        {
+            case UnitStyle::Int:
+                return (int64_t)std::round(value);
+
+            case UnitStyle::Sync:
+                return (int64_t)std::floor(value);
+
+            default:
+                return std::llround(value * std::pow(10.0, spec.numDecimals));
+        }
+    }
+
+    // display text for a denormalised value, shared by every text box
+    inline juce::String format(int index, float value)
+    {
+        const auto& spec = getSpec(index);
+
+        switch (spec.unit)
+        {
+            case UnitStyle::Int:
+                return juce::String((int)std::round(value));
+
+            case UnitStyle::Hertz:
+                if (value >= 1000.0f)
+                    return juce::String(value / 1000.0f, spec.numDecimals) + " kHz";
+                return juce::String(value, spec.numDecimals) + " Hz";
+
+            case UnitStyle::Percent:
+                return juce::String(value, spec.numDecimals) + " %";
+
+            case UnitStyle::Sync:
+                return spec.choices[juce::jlimit(0, spec.numChoices - 1, (int)std::floor(value))];
+
+            default:
+                return juce::String(value, spec.numDecimals);
+        }
+    }
+}
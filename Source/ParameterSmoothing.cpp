@@ -0,0 +1,60 @@
+/*
+  ==============================================================================
+
+    ParameterSmoothing.cpp
+
+  ==============================================================================
+*/
+
+#include "ParameterSmoothing.h"
+#include "Parameters.h"
+
+template <typename Function>
+void ParameterSmoothing::forEachRamp(Function&& function)
+{
+    for (int i = 0; i < numSpinners; i++)
+    {
+        function(rateFree[i]);
+        function(phase[i]);
+        function(curve[i]);
+    }
+    function(thresholdPhase);
+}
+
+void ParameterSmoothing::prepareToPlay(double sampleRate, const Parameters& parameters)
+{
+    forEachRamp([sampleRate] (Ramp& ramp) { ramp.value.reset(sampleRate, rampLength); });
+
+    for (int i = 0; i < numSpinners; i++)
+    {
+        rateFree[i].value.setCurrentAndTargetValue(parameters.rateFree[i]->get());
+        phase[i].value.setCurrentAndTargetValue(parameters.phase[i]->get());
+        curve[i].value.setCurrentAndTargetValue(parameters.curve[i]->get());
+    }
+    thresholdPhase.value.setCurrentAndTargetValue(parameters.thresholdPhase->get());
+    smoothing = false;
+}
+
+void ParameterSmoothing::updateTargets(const Parameters& parameters)
+{
+    for (int i = 0; i < numSpinners; i++)
+    {
+        rateFree[i].value.setTargetValue(parameters.rateFree[i]->get());
+        phase[i].value.setTargetValue(parameters.phase[i]->get());
+        curve[i].value.setTargetValue(parameters.curve[i]->get());
+    }
+    thresholdPhase.value.setTargetValue(parameters.thresholdPhase->get());
+
+    smoothing = false;
+    forEachRamp([this] (Ramp& ramp) { smoothing |= ramp.value.isSmoothing(); });
+}
+
+void ParameterSmoothing::renderSegment(int numSamples)
+{
+    // the spinners take one value per segment, the one before the ramp moves on
+    forEachRamp([numSamples] (Ramp& ramp)
+    {
+        ramp.start = ramp.value.getCurrentValue();
+        ramp.value.skip(numSamples);
+    });
+}
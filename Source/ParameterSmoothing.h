@@ -0,0 +1,52 @@
+/*
+  ==============================================================================
+
+    ParameterSmoothing.h
+
+  ==============================================================================
+*/
+
+#pragma once
+#include <JuceHeader.h>
+#include "Config.h"
+
+class Parameters;
+
+// ramps the parameters that move spinners or thresholds, so automation in
+// block sized steps can't jump a spinner straight over a threshold
+class ParameterSmoothing
+{
+public:
+    // processBlock steps in segments this long while anything is ramping
+    static constexpr int segmentSize = 32;
+
+    void prepareToPlay(double sampleRate, const Parameters& parameters);
+
+    // once per block, before any segment is rendered
+    void updateTargets(const Parameters& parameters);
+    bool isSmoothing() const { return smoothing; }
+
+    // moves every ramp on by numSamples, the getters then hold the values at the segment start
+    void renderSegment(int numSamples);
+
+    float getRateFree(int index) const     { return rateFree[index].start; }
+    float getPhase(int index) const        { return phase[index].start; }
+    float getCurve(int index) const        { return curve[index].start; }
+    float getThresholdPhase() const        { return thresholdPhase.start; }
+
+private:
+    struct Ramp
+    {
+        juce::SmoothedValue<float> value;
+        float start = 0.0f;
+    };
+
+    template <typename Function>
+    void forEachRamp(Function&& function);
+
+    std::array<Ramp, numSpinners> rateFree, phase, curve;
+    Ramp thresholdPhase;
+
+    static constexpr double rampLength = 0.05;
+    bool smoothing = false;
+};
@@ -13,37 +13,57 @@
 Parameters::Parameters(TingeAudioProcessor& p) : audioProcessor(p),
 apvts(audioProcessor, nullptr, "Parameters", createParameterLayout())
 {
+    // resolve every parameter once, everything after this indexes the table
+    for (int index = 0; index < ParameterRegistry::numParameters; index++)
+    {
+        parameters[(size_t)index] = apvts.getParameter(ParameterRegistry::getID(index));
+        jassert(parameters[(size_t)index] != nullptr && parameters[(size_t)index]->getParameterIndex() == index);
+    }
     
-    nudgeForward = std::make_unique<ParameterInstance>(audioProcessor, *this, "nudgeForward");
-    nudgeBackward = std::make_unique<ParameterInstance>(audioProcessor, *this, "nudgeBackward");
-    brake = std::make_unique<ParameterInstance>(audioProcessor, *this, "brake");
-    jog = std::make_unique<ParameterInstance>(audioProcessor, *this, "jog");
-
-    hold = std::make_unique<ParameterInstance>(audioProcessor, *this, "hold");
-    reset = std::make_unique<ParameterInstance>(audioProcessor, *this, "reset");
-    resetMode = std::make_unique<ParameterInstance>(audioProcessor, *this, "resetMode");
+    auto make = [this] (ParameterRegistry::Kind kind, int spinner = 0)
+    {
+        const int index = ParameterRegistry::indexOf(kind, spinner);
+        auto instance = std::make_unique<ParameterInstance>(audioProcessor, *this, index);
+        instances[(size_t)index] = instance.get();
+        return instance;
+    };
     
+    nudgeForward = make(ParameterRegistry::nudgeForward);
+    nudgeBackward = make(ParameterRegistry::nudgeBackward);
+    brake = make(ParameterRegistry::brake);
+    jog = make(ParameterRegistry::jog);
+
+    hold = make(ParameterRegistry::hold);
+    reset = make(ParameterRegistry::reset);
+    resetMode = make(ParameterRegistry::resetMode);
+
+    overlap = make(ParameterRegistry::overlap);
+    valueSlew = make(ParameterRegistry::valueSlew);
+
+    thresholdMode = make(ParameterRegistry::thresholdMode);
+    thresholdPhase = make(ParameterRegistry::thresholdPhase);
+    maxThreshold = make(ParameterRegistry::maxThreshold);
+    ccControl = make(ParameterRegistry::ccControl);
+    
+    for (int i = 0; i < numSpinners; i++){
+        rateFree[i] = make(ParameterRegistry::rateFree, i);
+        rateSync[i] = make(ParameterRegistry::rateSync, i);
+        rateMode[i] = make(ParameterRegistry::rateMode, i);
+        phase[i] = make(ParameterRegistry::phase, i);
+        opacity[i] = make(ParameterRegistry::opacity, i);
+        curve[i] = make(ParameterRegistry::curve, i);
+    }
+}
 
-    overlap = std::make_unique<ParameterInstance>(audioProcessor, *this, "overlap");
-    valueSlew = std::make_unique<ParameterInstance>(audioProcessor, *this, "valueSlew");
-
-    thresholdMode = std::make_unique<ParameterInstance>(audioProcessor, *this, "thresholdMode");
-    thresholdPhase = std::make_unique<ParameterInstance>(audioProcessor, *this, "thresholdPhase");
-
-    maxThreshold = std::make_unique<ParameterInstance>(audioProcessor, *this, "maxThreshold");
+bool Parameters::updateSafeValues()
+{
+    changed.store(false, std::memory_order_relaxed);
     
+    bool anyMoved = false;
+    for (auto* instance : instances)
+        anyMoved |= instance->updateSafe();
     
-    for (int i = 0; i < 3; i++){
-        auto incr = juce::String(i);
-        rateFree[i] = std::make_unique<ParameterInstance>(audioProcessor, *this, "rateFree" + incr);
-        rateSync[i] = std::make_unique<ParameterInstance>(audioProcessor, *this, "rateSync" + incr);
-        rateMode[i]
-        = std::make_unique<ParameterInstance>(audioProcessor, *this, "rateMode" + incr);
-
-        phase[i] = std::make_unique<ParameterInstance>(audioProcessor, *this, "phase" + incr);
-        opacity[i] = std::make_unique<ParameterInstance>(audioProcessor, *this, "opacity" + incr);
-        curve[i] = std::make_unique<ParameterInstance>(audioProcessor, *this, "curve" + incr);
-    }
+    return anyMoved;
 }
 
 juce::AudioProcessorValueTreeState::ParameterLayout
@@ -51,158 +71,79 @@ Parameters::createParameterLayout()
 {
     juce::AudioProcessorValueTreeState::ParameterLayout layout;
 
-    layout.add(std::make_unique<juce::AudioParameterInt>(juce::ParameterID { "nudgeForward", 1},
-                                                         "Nudge Forward",
-                                                         0, 1, 0));
-
-    layout.add(std::make_unique<juce::AudioParameterInt>(juce::ParameterID { "nudgeBackward", 1},
-                                                     "Nudge Backward",
-                                                     0, 1, 0));
-    
-    layout.add(std::make_unique<juce::AudioParameterInt>(juce::ParameterID { "brake", 1},
-                                                 "Brake",
-                                                 0, 1, 0));
-    
-    layout.add(std::make_unique<juce::AudioParameterFloat>(juce::ParameterID { "jog", 1},
-                                                           "Jog",
-                                                           juce::NormalisableRange<float> { 0.0f, 100.0f, 0.1 }, 100.0f));
-
-    layout.add(std::make_unique<juce::AudioParameterBool>(juce::ParameterID { "reset", 1},
-                                                          "Reset",
-                                                           false));
-
-    layout.add(std::make_unique<juce::AudioParameterChoice>(juce::ParameterID { "resetMode", 1},
-                                                            "Reset Mode", juce::StringArray { "Manual Reset", "Hold & Reset on Clear", "Hold on Clear" }, 0));
-    
-    layout.add(std::make_unique<juce::AudioParameterInt>(juce::ParameterID { "hold", 1},
-                                                 "Hold",
-                                                 0, 1, 0));
-
-    layout.add(std::make_unique<juce::AudioParameterInt>(juce::ParameterID { "overlap", 1},
-                                                           "Overlap", 0, 6, 6));
-
-    layout.add(std::make_unique<juce::AudioParameterFloat>(juce::ParameterID { "valueSlew", 1},
-                                                           "Value Slew",
-                                                           juce::NormalisableRange<float> { 0.0f, 100.0f, 0.1 }, 20.0f));
-        
-    layout.add(std::make_unique<juce::AudioParameterChoice>(juce::ParameterID { "thresholdMode", 1},
-                                                            "Threshold Mode", juce::StringArray { "EquiDistant", "Fill", "Harmonic", "Clusters", "Sequential", "Fibonacci" }, 0));
-
-    layout.add(std::make_unique<juce::AudioParameterFloat>(juce::ParameterID { "thresholdPhase", 1},
-                                                           "Threshold Phase",
-                                                           juce::NormalisableRange<float> { 0.0f, 100.0f, 0.1 }, 50.0f));
-
-    layout.add(std::make_unique<juce::AudioParameterInt>(juce::ParameterID { "maxThreshold", 1},
-                                                           "Max Threshold", 1, 16, 8));
-
-    
-    std::array<float, 3> phaseDefaults = { 0.0f, 33.0f, 66.0f };
-
-    for(int rotation = 0; rotation < 3; rotation++)
+    // generated from the registry, in table order so the processor indices match it
+    for (int index = 0; index < ParameterRegistry::numParameters; index++)
     {
-        juce::String rateFreeID = "rateFree" + juce::String(rotation);
-        juce::String rateFreeName = "RateFree" + juce::String(rotation + 1);
-        
-        layout.add(std::make_unique<juce::AudioParameterFloat>(juce::ParameterID { rateFreeID, 1},
-                                                               rateFreeName,
-                                                               juce::NormalisableRange<float> { -8.0f, 8.0f, 0.01 }, 0.0f));
-        
-        juce::String rateSyncID = "rateSync" + juce::String(rotation);
-        juce::String rateSyncName = "Rate Sync " + juce::String(rotation + 1);
+        const auto& spec = ParameterRegistry::getSpec(index);
+        const juce::ParameterID id { ParameterRegistry::getID(index), spec.version };
+        const auto name = ParameterRegistry::getName(index);
+        const float defaultValue = ParameterRegistry::getDefault(index);
         
-        layout.add(std::make_unique<juce::AudioParameterChoice>(
-            juce::ParameterID { rateSyncID, 1 },
-            rateSyncName,
-            getSyncRateOptions(),
-            22));
-        
-        juce::String rateModeID = "rateMode" + juce::String(rotation);
-        juce::String rateModeName = "Rate Mode " + juce::String(rotation + 1);
-        
-        layout.add(std::make_unique<juce::AudioParameterBool>(juce::ParameterID { rateModeID, 1},
-                                                              rateModeName, false));
-        
-        juce::String phaseID = "phase" + juce::String(rotation);
-        juce::String phaseName = "Phase " + juce::String(rotation + 1);
-
-        layout.add(std::make_unique<juce::AudioParameterFloat>(juce::ParameterID { phaseID, 1},
-                                                               phaseName,
-                                                               juce::NormalisableRange<float> { -100.0f, 100.0f, 0.01 }, phaseDefaults[rotation]));
-        
-        juce::String opacityID = "opacity" + juce::String(rotation);
-        juce::String opacityName = "Opacity " + juce::String(rotation + 1);
-        
-        layout.add(std::make_unique<juce::AudioParameterFloat>(juce::ParameterID { opacityID, 1},
-                                                               opacityName,
-                                                               juce::NormalisableRange<float> { 0.0, 100.0f, 0.1f }, 80.0f));
-        
-        juce::String curveID = "curve" + juce::String(rotation);
-        juce::String curveName = "Curve " + juce::String(rotation + 1);
-        
-        layout.add(std::make_unique<juce::AudioParameterFloat>(juce::ParameterID { curveID, 1},
-                                                               curveName,
-                                                               juce::NormalisableRange<float> { 50.0f, 200.0f, 0.01 }, 100.0f));
+        switch (spec.type)
+        {
+            case ParameterRegistry::Type::Int:
+                layout.add(std::make_unique<juce::AudioParameterInt>(id, name, (int)spec.start, (int)spec.end, (int)defaultValue));
+                break;
+                
+            case ParameterRegistry::Type::Float:
+                layout.add(std::make_unique<juce::AudioParameterFloat>(id, name,
+                                                                       juce::NormalisableRange<float> { spec.start, spec.end, spec.interval },
+                                                                       defaultValue));
+                break;
+                
+            case ParameterRegistry::Type::Bool:
+                layout.add(std::make_unique<juce::AudioParameterBool>(id, name, defaultValue != 0.0f));
+                break;
+                
+            case ParameterRegistry::Type::Choice:
+                layout.add(std::make_unique<juce::AudioParameterChoice>(id, name, ParameterRegistry::getChoices(spec), (int)defaultValue));
+                break;
+        }
     }
 
     return layout;
 }
 
-ParameterInstance::ParameterInstance(TingeAudioProcessor& p, Parameters& pm, juce::String paramID) : audioProcessor(p), param(pm)
+ParameterInstance::ParameterInstance(TingeAudioProcessor& p, Parameters& pm, int index) : audioProcessor(p), param(pm)
 {
-    this->paramID = paramID;
-    
-    float initValue = param.apvts.getRawParameterValue(paramID)->load();
-    value.store(initValue);
-    valueSafe = initValue;
-    cachedValue.store(initValue);
+    paramID = ParameterRegistry::getID(index);
 
-    if (auto* parameter = dynamic_cast<juce::AudioProcessorParameterWithID*>(param.apvts.getParameter(paramID)))
+    // resolved once by Parameters, the listener below may run on the audio thread
+    rangedParam = param.getParameterByIndex(index);
+    if (rangedParam != nullptr)
     {
-        if (auto* ranged = dynamic_cast<juce::RangedAudioParameter*>(parameter))
-        {
-            rangedParam = ranged;
-            rangedParam->addListener(this);
-        }
+        range = rangedParam->getNormalisableRange();
+        rangedParam->addListener(this);
+        
+        float initValue = range.convertFrom0to1(rangedParam->getValue());
+        value.store(initValue);
+        valueSafe = initValue;
     }
 }
 
-void ParameterInstance::parameterValueChanged (int /*maybe unused*/, float newValue)
+ParameterInstance::~ParameterInstance()
 {
-    // load atomics for thread safe reading
-    cachedValue.store(newValue);
-    triggerUpdate();
-    triggerAsyncUpdate();
+    if (rangedParam != nullptr)
+        rangedParam->removeListener(this);
 }
 
-void ParameterInstance::handleAsyncUpdate()
+void ParameterInstance::parameterValueChanged (int /*maybe unused*/, float newValue)
 {
-    if (rangedParam)
-    {
-        float newValue = cachedValue.load(std::memory_order_relaxed);
-        
-        if (auto* parameter = dynamic_cast<juce::AudioProcessorParameterWithID*>(param.apvts.getParameter(paramID)))
-        {
-            if (auto* rangedParam = dynamic_cast<juce::RangedAudioParameter*>(parameter))
-            {
-                valueSafe = rangedParam->convertFrom0to1(newValue);
-            }
-        }
-    }
+    // same as RangedAudioParameter::convertFrom0to1, without the virtual call
+    value.store(range.snapToLegalValue(range.convertFrom0to1(newValue)), std::memory_order_relaxed);
+    param.markChanged();
 }
 
-void ParameterInstance::triggerUpdate()
+bool ParameterInstance::updateSafe()
 {
-    if (rangedParam)
-    {
-        float newValue = cachedValue.load(std::memory_order_relaxed);
-        if (auto* parameter = dynamic_cast<juce::AudioProcessorParameterWithID*>(param.apvts.getParameter(paramID)))
-        {
-            if (auto* rangedParam = dynamic_cast<juce::RangedAudioParameter*>(parameter))
-            {
-                value.store(rangedParam->convertFrom0to1(newValue));
-            }
-        }
-    }
+    // any number of changes since the last frame end up as one call here
+    const float newValue = value.load(std::memory_order_relaxed);
+    if (newValue == valueSafe)
+        return false;
+    
+    valueSafe = newValue;
+    listeners.call([newValue] (Listener& l) { l.safeValueChanged(newValue); });
+    return true;
 }
 
 float ParameterInstance::get() const noexcept
@@ -11,6 +11,7 @@
 #pragma once
 #include <JuceHeader.h>
 #include "PluginProcessor.h"
+#include "ParameterRegistry.h"
 
 class TingeAudioProcessor;
 class ParameterInstance;
@@ -20,35 +21,50 @@ public:
     Parameters(TingeAudioProcessor& p);
     
     static juce::AudioProcessorValueTreeState::ParameterLayout createParameterLayout();
+    
+    // message thread, once per frame, hands the latest values to getSafe().
+    // true when any of them moved
+    bool updateSafeValues();
+    
+    // any thread, set by every host or gui change until the next updateSafeValues()
+    bool hasChanges() const noexcept { return changed.load(std::memory_order_relaxed); }
+    void markChanged() noexcept { changed.store(true, std::memory_order_relaxed); }
     static juce::StringArray getSyncRateOptions()
     {
-        return juce::StringArray {
-            // negative values
-            "-1/32", "-1/24", "-1/16",
-            "-1/12", "-1/8", "-1/6", "-3/16",
-            "-1/4", "-5/16", "-1/3", "-3/8",
-            "-1/2", "-3/4", "-1",  "-2",
-            "-3", "-4", "-6", "-8",
-            
-            // no motion
-            "No Motion",
-            
-            // positive values
-            "8", "6", "4", "3",
-            "2", "1", "3/4", "1/2",
-            "3/8", "1/3", "5/16", "1/4",
-            "3/16", "1/6", "1/8", "1/12",
-            "1/16", "1/24", "1/32"
-        };
+        return ParameterRegistry::getChoices(ParameterRegistry::specs[ParameterRegistry::rateSync]);
+    }
+    
+    // typed lookups by table index, no strings on the way
+    ParameterInstance& get(ParameterRegistry::Kind kind, int spinner = 0) const
+    {
+        return *instances[(size_t)ParameterRegistry::indexOf(kind, spinner)];
+    }
+    
+    juce::RangedAudioParameter* getParameter(ParameterRegistry::Kind kind, int spinner = 0) const
+    {
+        return getParameterByIndex(ParameterRegistry::indexOf(kind, spinner));
+    }
+    
+    juce::RangedAudioParameter* getParameterByIndex(int index) const
+    {
+        return parameters[(size_t)index];
+    }
+    
+    ParameterInstance& getByIndex(int index) const
+    {
+        return *instances[(size_t)index];
     }
     
 private:
     TingeAudioProcessor& audioProcessor;
+    std::array<juce::RangedAudioParameter*, ParameterRegistry::numParameters> parameters {};
+    std::array<ParameterInstance*, ParameterRegistry::numParameters> instances {};
+    std::atomic<bool> changed { false };
     
 public:
     juce::AudioProcessorValueTreeState apvts;
 
-    std::array<std::unique_ptr<ParameterInstance>, 3>
+    std::array<std::unique_ptr<ParameterInstance>, numSpinners>
     rateFree, rateSync, rateMode, phase, curve, opacity;
     
     std::unique_ptr<ParameterInstance>
@@ -62,20 +78,31 @@ public:
     valueSlew,
     thresholdMode,
     thresholdPhase,
-    maxThreshold;
+    maxThreshold,
+    ccControl;
     
 };
 
-class ParameterInstance : public juce::AudioProcessorParameter::Listener, juce::AsyncUpdater
+class ParameterInstance : public juce::AudioProcessorParameter::Listener
 {
 public:
-    ParameterInstance(TingeAudioProcessor& p, Parameters& pm, juce::String paramID);
+    ParameterInstance(TingeAudioProcessor& p, Parameters& pm, int index);
+    ~ParameterInstance() override;
+    
+    // message thread, told at most once per frame and only when the value moved
+    struct Listener
+    {
+        virtual ~Listener() = default;
+        virtual void safeValueChanged(float newValue) = 0;
+    };
+    
+    void addListener(Listener* listener) { listeners.add(listener); }
+    void removeListener(Listener* listener) { listeners.remove(listener); }
     
     //==============================================================================
     void parameterValueChanged (int /*maybe unused*/, float newValue) override;
     void parameterGestureChanged (int parameterIndex, bool gestureIsStarting) override {}
-    void handleAsyncUpdate() override;
-    void triggerUpdate();
+    bool updateSafe();
     
     //==============================================================================
     float get() const noexcept;
@@ -84,10 +111,11 @@ public:
 private:
     float valueSafe;
     std::atomic<float> value;
-    std::atomic<float> cachedValue;
 
     juce::String paramID;
     juce::RangedAudioParameter* rangedParam = nullptr;
+    juce::NormalisableRange<float> range; // copy, so denormalising never touches the parameter
+    juce::ListenerList<Listener> listeners;
 
     TingeAudioProcessor& audioProcessor;
     Parameters& param;
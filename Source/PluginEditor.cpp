@@ -10,14 +10,14 @@
 #include "PluginEditor.h"
 
 //==============================================================================
-TingeAudioProcessorEditor::TingeAudioProcessorEditor (TingeAudioProcessor& p, std::atomic<std::array<float, 3>>& phases, std::atomic<std::array<float, 16>>& noteValues)
-    : AudioProcessorEditor (&p), phasesAtomic(phases), noteValuesAtomic(noteValues), audioProcessor (p)
+TingeAudioProcessorEditor::TingeAudioProcessorEditor (TingeAudioProcessor& p, TripleBuffer<TelemetrySnapshot>& telemetry)
+    : AudioProcessorEditor (&p), telemetry(telemetry), audioProcessor (p)
 {
     addAndMakeVisible(spinnerGraphics);
     spinnerGraphics.setInterceptsMouseClicks(false, false);
     
     // global controls layout
-    globalLayout = std::make_unique<GlobalControlsLayout>(audioProcessor);
+    globalLayout = std::make_unique<GlobalControlsLayout>(audioProcessor, frameClock);
     addAndMakeVisible(*globalLayout);
 
     // rotation layout
@@ -46,23 +46,31 @@ TingeAudioProcessorEditor::TingeAudioProcessorEditor (TingeAudioProcessor& p, st
     
     // editor size and animation setup
     setSize (550, 550);
-    startTimerHz(60);
     animationSlew.setSampleRate(60);
+    animationSlew.setEnvelopeSlew(3000.0f, 3000.0f);
 
     
     // initialize parameters
-    controlState = audioProcessor.params->apvts.state.getProperty("controlState", 0);
-    
-    viewState = audioProcessor.params->apvts.state.getProperty("viewState", 0);
+    controlState = audioProcessor.getEditorState().controlState;
+    viewState = audioProcessor.getEditorState().viewState;
     rotationLayout1->setVisible(controlState);
     rotationLayout2->setVisible(controlState);
     rotationLayout3->setVisible(controlState);
     thresholdLayout->setVisible(!controlState);
-
+    updateGraphicsParameters();
+    
+    // while everything sleeps, host automation and moving spinners wake the editor.
+    // a host running audio publishes every block, so fresh telemetry alone isn't enough
+    frameClock.setWakeCheck(*this, [this]
+    {
+        return isShowing() && (audioProcessor.params->hasChanges() || readTelemetry());
+    });
+    frameClock.wake(*this);
 }
 
 TingeAudioProcessorEditor::~TingeAudioProcessorEditor()
 {
+    frameClock.remove(*this);
     spinnerTabButton.removeListener(this);
     controlWindowToggle.removeListener(this);
     thresholdTabButton.removeListener(this);
@@ -187,44 +195,40 @@ void TingeAudioProcessorEditor::resized()
     rotationLayout3->setFontSize(12);
 }
 
-void TingeAudioProcessorEditor::timerCallback()
+void TingeAudioProcessorEditor::updateGraphicsParameters()
 {
-    animationSlew.setEnvelopeSlew(3000.0f, 3000.0f);
-    animationValue = animationSlew.generateEnvelope();
-    repaint();
+    spinnerGraphics.setOpacity(audioProcessor.params->opacity[0]->getSafe(),
+                               audioProcessor.params->opacity[1]->getSafe(),
+                               audioProcessor.params->opacity[2]->getSafe());
     
-    phases = phasesAtomic.load();
-    for (int index = 0; index < 3; index++)
-    {
-        spinnerGraphics.setParams(index,
-                                  phases[index],
-                                  audioProcessor.params->opacity[0]->getSafe(),
-                                  audioProcessor.params->opacity[1]->getSafe(),
-                                  audioProcessor.params->opacity[2]->getSafe());
-    }
-    
-    std::array<float, 16> heldNotes = noteValuesAtomic.load();
-    spinnerGraphics.setNumThresholds(heldNotes);
-    
-    spinnerGraphics.processThreshold(static_cast<MIDIProcessor::thresholdMode>(audioProcessor.params->thresholdMode->getSafe()),
-                                     audioProcessor.params->thresholdPhase->getSafe(),
-                                     audioProcessor.params->maxThreshold->getSafe());
-        
     thresholdLayout->graphics.setParams(audioProcessor.params->thresholdMode->getSafe(),
                                         audioProcessor.params->thresholdPhase->getSafe(),
                                         audioProcessor.params->maxThreshold->getSafe());
     
     spinnerGraphics.setOverlapIndex(audioProcessor.params->overlap->getSafe());
-    
+}
 
-     
-    overlapSlider.repaint();
+bool TingeAudioProcessorEditor::advanceFrame()
+{
+    const bool parametersMoved = audioProcessor.params->updateSafeValues();
+    const bool telemetryMoved = readTelemetry();
     
-    if (auto* processor = dynamic_cast<TingeAudioProcessor*>(&audioProcessor))
-    {
-        processor->saveEditorState(viewState, controlState);
-        
-    }
-
+    if (parametersMoved)
+        updateGraphicsParameters();
+    
+    // the slide between the two views, the layout is placed in paint
+    const bool animating = !animationSlew.isSettled();
+    animationValue = animationSlew.generateEnvelope();
+    if (animating)
+        frameClock.invalidate(*this);
+    
+    if (parametersMoved || telemetryMoved || animating)
+        idleFrames = 0;
+    
+    return ++idleFrames < framesBeforeSleep;
 }
 
+bool TingeAudioProcessorEditor::readTelemetry()
+{
+    return telemetry.read(snapshot) && spinnerGraphics.setTelemetry(snapshot);
+}
@@ -21,14 +21,15 @@
 #include "GraphicsHelper.h"
 #include "MiscGraphics.h"
 #include "DSP.h"
+#include "FrameClock.h"
 //==============================================================================
 
 class PresetControlsLayout;
 
-class TingeAudioProcessorEditor  : public juce::AudioProcessorEditor, juce::Button::Listener, juce::Timer, GraphicsHelper
+class TingeAudioProcessorEditor  : public juce::AudioProcessorEditor, juce::Button::Listener, FrameClock::Client, GraphicsHelper
 {
 public:
-    TingeAudioProcessorEditor (TingeAudioProcessor&, std::atomic<std::array<float, 3>>& phases, std::atomic<std::array<float, 16>>& noteValues);
+    TingeAudioProcessorEditor (TingeAudioProcessor&, TripleBuffer<TelemetrySnapshot>& telemetry);
     ~TingeAudioProcessorEditor() override;
 
     //==============================================================================
@@ -36,7 +37,9 @@ public:
     void resized() override;
 
     //==============================================================================
-    void timerCallback() override;
+    bool advanceFrame() override;
+    bool readTelemetry();
+    void updateGraphicsParameters();
     
     void mouseDown(const juce::MouseEvent &m) override
     {
@@ -47,6 +50,8 @@ public:
             animationSlew.triggerEnvelope(false);
             viewState = true;
         }
+        audioProcessor.saveEditorState(viewState, controlState);
+        frameClock.wake(*this);
     }
     
     void buttonClicked(juce::Button *b) override
@@ -70,7 +75,9 @@ public:
             thresholdLayout->setVisible(true);
             controlState = false;
         }
-
+        
+        audioProcessor.saveEditorState(viewState, controlState);
+        repaint();
     }
      
     void buttonStateChanged(juce::Button *) override {}
@@ -90,42 +97,25 @@ private:
     
     
     bool viewState = false, controlState = true;
-    float animationValue;
+    float animationValue = 0.0f;
     
     // trying it out
     LowPassGate animationSlew;
     
-    juce::VBlankAnimatorUpdater updater { this };
-    
-    juce::Animator isoEnterToggle = juce::ValueAnimatorBuilder {}
-        .withEasing(juce::Easings::createEaseInOut())
-        .withDurationMs(1200.0f)
-        .withValueChangedCallback([this] (auto value){ // lambda function
-            animationValue = 1.0f - value;
-            repaint();
-        })
-        .build();
+    // frames the editor keeps polling after the last change before it sleeps
+    static constexpr int framesBeforeSleep = 60;
+    int idleFrames = 0;
     
-    juce::Animator isoExitToggle = juce::ValueAnimatorBuilder {}
-        .withEasing(juce::Easings::createEaseInOut())
-        .withDurationMs(1200.0f)
-        .withValueChangedCallback([this] (auto value){ // lambda function
-            animationValue = value;
-            repaint();
-        })
-        .build();
-     
-    std::atomic<std::array<float, 3>>& phasesAtomic;
-    std::array<float, 3> phases;
-
-    std::atomic<std::array<float, 16>>& noteValuesAtomic;
+    TripleBuffer<TelemetrySnapshot>& telemetry;
+    TelemetrySnapshot snapshot;
     
     std::unique_ptr<juce::AudioProcessorValueTreeState::SliderAttachment>
     overlapAttachment;
     
 
     
-    SpinnerGraphics spinnerGraphics;
+    FrameClock frameClock { *this };
+    SpinnerGraphics spinnerGraphics { frameClock };
     std::unique_ptr<PresetControlsLayout> presetLayout;
 
     std::unique_ptr<SpinnerLayout> rotationLayout1, rotationLayout2, rotationLayout3;
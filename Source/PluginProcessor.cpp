@@ -8,6 +8,8 @@
 
 #include "PluginProcessor.h"
 #include "PluginEditor.h"
+#include "StateFormat.h"
+#include "Presets.h"
 
 //==============================================================================
 TingeAudioProcessor::TingeAudioProcessor()
@@ -86,11 +88,12 @@ void TingeAudioProcessor::changeProgramName (int index, const juce::String& newN
 //==============================================================================
 void TingeAudioProcessor::prepareToPlay (double sampleRate, int samplesPerBlock)
 {
-    for (int index = 0; index < 3; index++){
+    for (int index = 0; index < numSpinners; index++){
         rotation[index].reset();
         rotation[index].prepareToPlay(sampleRate, samplesPerBlock);
     }
     midiProcessor.prepareToPlay(sampleRate);
+    smoothing.prepareToPlay(sampleRate, *params);
 }
 
 void TingeAudioProcessor::releaseResources()
@@ -141,14 +144,33 @@ juce::AudioProcessor::BusesProperties TingeAudioProcessor::getDefaultLayout()
 void TingeAudioProcessor::processBlock (juce::AudioBuffer<float>& buffer, juce::MidiBuffer& midiMessages)
 {
     juce::ScopedNoDenormals noDenormals;
+    
+    {
+        const ScopedAllocationTrap allocationTrap;
+        renderBlock(buffer, midiMessages);
+    }
+    
+    // the one write into the host's buffer. hosts keep it between callbacks,
+    // so it only grows until it has held the busiest block
+    midiProcessor.handOver(midiMessages);
+}
+
+void TingeAudioProcessor::renderBlock(juce::AudioBuffer<float>& buffer, const juce::MidiBuffer& midiMessages)
+{
     auto totalNumInputChannels  = getTotalNumInputChannels();
     auto totalNumOutputChannels = getTotalNumOutputChannels();
 
     for (auto i = totalNumInputChannels; i < totalNumOutputChannels; ++i)
         buffer.clear (i, 0, buffer.getNumSamples());
     
-    midiProcessor.holdPitches(midiMessages);
+    const int numSamples = buffer.getNumSamples();
+    
+    // the whole block's output is built in the processor's reserved buffer, the
+    // input is filtered into it first, without the CCs the parameter events take
+    parameterEvents.collect(midiMessages, numSamples, (bool)params->ccControl->get());
+    midiProcessor.holdPitches(midiMessages, parameterEvents);
     midiProcessor.setHold(midiMessages, (bool)params->hold->get());
+    auto& output = midiProcessor.getOutput();
     
     heldPitches = midiProcessor.getheldPitches();
     
@@ -156,45 +178,104 @@ void TingeAudioProcessor::processBlock (juce::AudioBuffer<float>& buffer, juce::
     midiProcessor.setSlewAmount(params->valueSlew->get());
 
 
-    for (int i = 0; i < 3; i++){
-        rotation[i].playhead(getPlayHead());
-        
-        rotation[i].setRate(params->rateSync[i]->get(),
-                            params->rateFree[i]->get(),
-                            params->rateMode[i]->get(),
-                            params->phase[i]->get(),
-                            params->curve[i]->get());
-        
-        rotation[i].nudge(params->nudgeForward->get(),
-                          params->nudgeBackward->get(),
-                          params->brake->get(),
-                          params->jog->get());
-        
-        rotation[i].resetMode(params->resetMode->get(),
-                              midiProcessor.getNumHeldNotes(),
-                              params->reset->get());
+    // block sized steps while nothing ramps, short segments while automation moves,
+    // and a new segment at every timestamped nudge, brake, reset or rate change
+    smoothing.updateTargets(*params);
+    const int segmentSize = smoothing.isSmoothing() ? ParameterSmoothing::segmentSize : numSamples;
+    
+    int start = 0;
+    do
+    {
+        const bool eventsChanged = parameterEvents.apply(start);
+        const int length = std::min({ segmentSize, numSamples - start, parameterEvents.getNextBoundary(start) - start });
+        smoothing.renderSegment(length);
         
+        for (int i = 0; i < numSpinners; i++){
+            if (start == 0)
+                rotation[i].playhead(getPlayHead());
+            
+            rotation[i].setRate(parameterEvents.getRateSync(i, (int)params->rateSync[i]->get()),
+                                smoothing.getRateFree(i),
+                                params->rateMode[i]->get(),
+                                smoothing.getPhase(i),
+                                smoothing.getCurve(i));
+            
+            if (start == 0 || eventsChanged)
+            {
+                rotation[i].nudge(parameterEvents.getSwitch(ParameterEvents::nudgeForwardCC, (bool)params->nudgeForward->get()),
+                                  parameterEvents.getSwitch(ParameterEvents::nudgeBackwardCC, (bool)params->nudgeBackward->get()),
+                                  parameterEvents.getSwitch(ParameterEvents::brakeCC, (bool)params->brake->get()),
+                                  params->jog->get());
+                
+                rotation[i].resetMode(params->resetMode->get(),
+                                      midiProcessor.getNumHeldNotes(),
+                                      parameterEvents.getSwitch(ParameterEvents::resetCC, (bool)params->reset->get()));
+            }
+            
+            midiProcessor.setSpinnerValues(i,
+                                           rotation[i].getPhase(), // rotation at the first sample
+                                           params->opacity[i]->get());
+        }
         
-        for(int sample = 0; sample < buffer.getNumSamples(); ++sample){
-            rotation[i].accumulate();
+        if (start == 0)
+        {
+            // interaction at the start of the block, crossings inside it are placed at their own sample
+            midiProcessor.processInteraction(params->thresholdMode->get(),
+                                             smoothing.getThresholdPhase(),
+                                             params->maxThreshold->get());
+            midiProcessor.notePlayback(output, 0);
+        }
+        else
+        {
+            midiProcessor.updateInteraction(output,
+                                            start,
+                                            params->thresholdMode->get(),
+                                            smoothing.getThresholdPhase(),
+                                            params->maxThreshold->get());
         }
         
-        midiProcessor.setSpinnerValues(i,
-                                       rotation[i].getPhase(), // real time rotation
-                                       params->opacity[i]->get());
+        advanceSpinners(length);
+        midiProcessor.processCrossings(output, start, length);
         
-        phases[i] = rotation[i].getPhase(); // for atomic
+        start += length;
     }
-    midiProcessor.processInteraction(params->thresholdMode->get(),
-                                     params->thresholdPhase->get(),
-                                     params->maxThreshold->get());
-    midiProcessor.notePlayback(midiMessages);
+    while (start < numSamples);
+    
+    auto& snapshot = telemetry.getWriteBuffer();
+    for (int i = 0; i < numSpinners; i++)
+        snapshot.phases[i] = rotation[i].getPhase();
     
-    phasesAtomic.store(phases);
-    heldPitchesAtomic.store(heldPitches);
+    snapshot.heldPitches = heldPitches;
+    midiProcessor.writeTelemetry(snapshot);
+    telemetry.publish();
 
 }
 
+void TingeAudioProcessor::advanceSpinners(int numSamples)
+{
+    for (int i = 0; i < numSpinners; i++){
+        rotation[i].beginSegment();
+        spinnerBank.load(i, rotation[i]);
+    }
+    
+   #if TINGE_VERIFY_SPINNER_BANK
+    auto reference = rotation;
+    for (auto& spinner : reference)
+        spinner.advance(numSamples);
+   #endif
+    
+    spinnerBank.advance(numSamples);
+    
+    for (int i = 0; i < numSpinners; i++){
+        spinnerBank.store(i, rotation[i]);
+       #if TINGE_VERIFY_SPINNER_BANK
+        jassert(rotation[i].matches(reference[i]));
+       #endif
+        
+        midiProcessor.setSpinnerSegment(i, rotation[i].getSegment(numSamples));
+    }
+}
+
 //==============================================================================
 bool TingeAudioProcessor::hasEditor() const
 {
@@ -203,28 +284,61 @@ bool TingeAudioProcessor::hasEditor() const
 
 juce::AudioProcessorEditor* TingeAudioProcessor::createEditor()
 {
-    return new TingeAudioProcessorEditor (*this, phasesAtomic, heldPitchesAtomic);
+    return new TingeAudioProcessorEditor (*this, telemetry);
 }
 
 //==============================================================================
 void TingeAudioProcessor::getStateInformation (juce::MemoryBlock& destData)
 {
-    copyXmlToBinary(*params->apvts.copyState().createXml(), destData);
+    StateFormat::State state;
+    for (int i = 0; i < ParameterRegistry::numParameters; i++)
+    {
+        const auto* parameter = params->getParameterByIndex(i);
+        state.values[(size_t)i] = parameter->convertFrom0to1(parameter->getValue());
+    }
+    
+    state.presetName = params->apvts.state.getProperty(PresetManager::presetNameProperty).toString();
+    state.viewState = editorState.viewState;
+    state.controlState = editorState.controlState;
+    StateFormat::write(state, destData);
 }
 
 void TingeAudioProcessor::setStateInformation (const void* data, int sizeInBytes)
 {
+    StateFormat::State state;
+    if (StateFormat::read(data, sizeInBytes, state))
+    {
+        for (int i = 0; i < ParameterRegistry::numParameters; i++)
+        {
+            auto* parameter = params->getParameterByIndex(i);
+            parameter->setValueNotifyingHost(parameter->convertTo0to1(state.values[(size_t)i]));
+        }
+        
+        params->apvts.state.setProperty(PresetManager::presetNameProperty, state.presetName, nullptr);
+        editorState.viewState = state.viewState;
+        editorState.controlState = state.controlState;
+        return;
+    }
+    
+    // sessions saved before the binary format
     const auto xmlState = getXmlFromBinary(data, sizeInBytes);
        if (xmlState == nullptr)
            return;
-       const auto newTree = juce::ValueTree::fromXml(*xmlState);
+       auto newTree = juce::ValueTree::fromXml(*xmlState);
+    
+    // the editor state travels with the session but doesn't live in the apvts
+    editorState.viewState = (bool)newTree.getProperty("viewState", false);
+    editorState.controlState = (bool)newTree.getProperty("controlState", false);
+    newTree.removeProperty("viewState", nullptr);
+    newTree.removeProperty("controlState", nullptr);
+    
     params->apvts.replaceState(newTree);
 }
 
 void TingeAudioProcessor::saveEditorState(bool viewState, bool controlState)
 {
-    params->apvts.state.setProperty("viewState", viewState, nullptr);
-    params->apvts.state.setProperty("controlState", controlState, nullptr);
+    editorState.viewState = viewState;
+    editorState.controlState = controlState;
 }
 
 //==============================================================================
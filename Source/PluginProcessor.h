@@ -10,10 +10,24 @@
 #include <JuceHeader.h>
 #include "Parameters.h"
 #include "MIDIProcessor.h"
+#include "SpinnerBank.h"
+#include "AllocationTrap.h"
+#include "ParameterSmoothing.h"
+#include "ParameterEvents.h"
+#include "Presets.h"
 //==============================================================================
 /**
 */
 class Parameters;
+
+// which view and control tab the editor shows. kept out of the apvts so
+// clicking around the editor doesn't notify its listeners, and only copied
+// into the saved state
+struct EditorState
+{
+    std::atomic<bool> viewState { false }, controlState { false };
+};
+
 class TingeAudioProcessor  : public juce::AudioProcessor
 {
 public:
@@ -56,19 +70,26 @@ public:
     void getStateInformation (juce::MemoryBlock& destData) override;
     void setStateInformation (const void* data, int sizeInBytes) override;
     void saveEditorState(bool viewState, bool controlState);
+    const EditorState& getEditorState() const { return editorState; }
     //==============================================================================
     std::unique_ptr<Parameters> params;
 
 private:
+    void renderBlock(juce::AudioBuffer<float>& buffer, const juce::MidiBuffer& midiMessages);
+    void advanceSpinners(int numSamples);
     
-    std::array<float, 3> phases;
-    std::atomic<std::array<float, 3>> phasesAtomic;
-
     std::array<float, 16> heldPitches;
-    std::atomic<std::array<float, 16>> heldPitchesAtomic;
+    TripleBuffer<TelemetrySnapshot> telemetry;
+    EditorState editorState;
+    
+    std::array<Spinner, numSpinners> rotation;
+    SpinnerBank<numSpinners> spinnerBank;
+    ParameterSmoothing smoothing;
+    ParameterEvents parameterEvents;
+    MIDIProcessor<numSpinners> midiProcessor;
     
-    std::array<Spinner, 3> rotation;
-    MIDIProcessor midiProcessor;
+    // keeps the preset index scanned while no editor is open
+    juce::SharedResourcePointer<SharedPresetIndex> presetIndex;
     //==============================================================================
     JUCE_DECLARE_NON_COPYABLE_WITH_LEAK_DETECTOR (TingeAudioProcessor)
 };
@@ -0,0 +1,286 @@
+/*
+  ==============================================================================
+
+    PresetBank.cpp
+
+  ==============================================================================
+*/
+
+#include "PresetBank.h"
+#include "PresetIndex.h"
+#include "Presets.h"
+#include "StateFormat.h"
+
+const juce::String PresetBank::extension { "tingebank" };
+
+PresetBank::PresetBank(const juce::File& file) : file(file)
+{
+    if (!file.existsAsFile())
+        return;
+
+    mapping = std::make_unique<juce::MemoryMappedFile>(file, juce::MemoryMappedFile::readOnly);
+    const auto* data = static_cast<const char*>(mapping->getData());
+    const auto size = mapping->getSize();
+
+    if (data == nullptr || size < sizeof(Header))
+        return;
+
+    const auto* candidate = reinterpret_cast<const Header*>(data);
+    if (candidate->magic != magic || candidate->version != version
+        || candidate->recordStride != getRecordStride(candidate->numParameters))
+    {
+        DBG("Unreadable preset bank: " + file.getFullPathName());
+        return;
+    }
+
+    const auto idsEnd = (juce::uint64)sizeof(Header) + (juce::uint64)candidate->numParameters * sizeof(juce::uint32);
+    const auto recordsEnd = (juce::uint64)candidate->recordsOffset + (juce::uint64)candidate->numPresets * candidate->recordStride;
+    if (idsEnd > candidate->recordsOffset || candidate->recordsOffset % 8 != 0
+        || recordsEnd > candidate->stringsOffset
+        || (juce::uint64)candidate->stringsOffset + candidate->stringsSize > size)
+        return;
+
+    juce::HashMap<juce::uint32, int> stored;
+    const auto* ids = reinterpret_cast<const juce::uint32*>(data + sizeof(Header));
+    for (juce::uint32 i = 0; i < candidate->numParameters; i++)
+        stored.set(ids[i], (int)i);
+
+    const auto& hashes = StateFormat::getIdHashes();
+    for (int i = 0; i < ParameterRegistry::numParameters; i++)
+        columns[(size_t)i] = stored.contains(hashes[(size_t)i]) ? stored[hashes[(size_t)i]] : -1;
+
+    header = candidate;
+    records = data + header->recordsOffset;
+    strings = data + header->stringsOffset;
+}
+
+int PresetBank::size() const
+{
+    return isOpen() ? (int)header->numPresets : 0;
+}
+
+const PresetBank::Record& PresetBank::getRecord(int index) const
+{
+    jassert(juce::isPositiveAndBelow(index, size()));
+    return *reinterpret_cast<const Record*>(records + (size_t)index * header->recordStride);
+}
+
+juce::String PresetBank::getString(juce::uint32 offset, juce::uint32 length) const
+{
+    if ((juce::uint64)offset + length > header->stringsSize)
+        return {};
+
+    return juce::String::fromUTF8(strings + offset, (int)length);
+}
+
+juce::String PresetBank::getName(int index) const
+{
+    const auto& record = getRecord(index);
+    return getString(record.nameOffset, record.nameLength);
+}
+
+juce::StringArray PresetBank::getTags(int index) const
+{
+    const auto& record = getRecord(index);
+    return juce::StringArray::fromTokens(getString(record.tagsOffset, record.tagsLength), ",", "");
+}
+
+juce::Time PresetBank::getModificationTime(int index) const
+{
+    return juce::Time(getRecord(index).modified);
+}
+
+std::array<float, ParameterRegistry::numParameters> PresetBank::getValues(int index) const
+{
+    const auto* stored = reinterpret_cast<const float*>(reinterpret_cast<const char*>(&getRecord(index)) + sizeof(Record));
+
+    std::array<float, ParameterRegistry::numParameters> values;
+    for (int i = 0; i < ParameterRegistry::numParameters; i++)
+        values[(size_t)i] = columns[(size_t)i] >= 0 ? stored[columns[(size_t)i]] : ParameterRegistry::getDefault(i);
+
+    return values;
+}
+
+int PresetBank::indexOf(const juce::String& name) const
+{
+    int start = 0, end = size();
+    while (start < end)
+    {
+        const int middle = (start + end) / 2;
+        const int order = getName(middle).compareNatural(name);
+
+        if (order == 0)
+            return middle;
+
+        if (order < 0)
+            start = middle + 1;
+        else
+            end = middle;
+    }
+    return -1;
+}
+
+juce::Array<int> PresetBank::search(const juce::String& text) const
+{
+    juce::Array<int> matches;
+    for (int i = 0; i < size(); i++)
+    {
+        const auto& record = getRecord(i);
+        if (getString(record.nameOffset, record.nameLength).containsIgnoreCase(text)
+            || getString(record.tagsOffset, record.tagsLength).containsIgnoreCase(text))
+            matches.add(i);
+    }
+    return matches;
+}
+
+juce::Array<juce::File> PresetBank::findBanks(const juce::File& directory)
+{
+    // Presets.tingebank and the numbered siblings write() creates, nothing else the user named
+    auto banks = directory.findChildFiles(juce::File::findFiles, false, "Presets*." + extension);
+    banks.removeIf([] (const juce::File& file)
+    {
+        return !file.getFileNameWithoutExtension().substring(7).containsOnly("0123456789");
+    });
+
+    std::sort(banks.begin(), banks.end(), [] (const juce::File& a, const juce::File& b)
+    {
+        return a.getLastModificationTime() > b.getLastModificationTime();
+    });
+    return banks;
+}
+
+juce::ValueTree PresetBank::createState(int index, const juce::Identifier& stateType) const
+{
+    juce::ValueTree state { stateType };
+    state.setProperty(PresetManager::presetNameProperty, getName(index), nullptr);
+
+    const auto tags = getTags(index);
+    if (!tags.isEmpty())
+        state.setProperty(PresetIndex::tagsAttribute, tags.joinIntoString(","), nullptr);
+
+    // the same children the apvts writes, so replaceState takes it as it is
+    const auto values = getValues(index);
+    for (int i = 0; i < ParameterRegistry::numParameters; i++)
+    {
+        state.appendChild(juce::ValueTree { "PARAM", { { "id", ParameterRegistry::getID(i) },
+                                                       { "value", values[i] } } }, nullptr);
+    }
+    return state;
+}
+
+bool PresetBank::exportPreset(int index, const juce::File& presetFile, const juce::Identifier& stateType) const
+{
+    const auto xml = createState(index, stateType).createXml();
+    return xml != nullptr && xml->writeTo(presetFile);
+}
+
+juce::File PresetBank::write(const juce::File& bankFile, const juce::Array<juce::File>& presetFiles)
+{
+    struct Entry
+    {
+        juce::String name, tags;
+        juce::int64 modified;
+        std::array<float, ParameterRegistry::numParameters> values;
+    };
+
+    std::vector<Entry> entries;
+    entries.reserve((size_t)presetFiles.size());
+
+    for (const auto& presetFile : presetFiles)
+    {
+        juce::XmlDocument document { presetFile };
+        const auto xml = document.getDocumentElement();
+        if (xml == nullptr)
+            continue;
+
+        const auto state = juce::ValueTree::fromXml(*xml);
+        Entry entry { presetFile.getFileNameWithoutExtension(),
+                      state.getProperty(PresetIndex::tagsAttribute).toString(),
+                      presetFile.getLastModificationTime().toMilliseconds(), {} };
+
+        // parameters the file doesn't have take their defaults
+        for (int i = 0; i < ParameterRegistry::numParameters; i++)
+        {
+            const auto parameter = state.getChildWithProperty("id", ParameterRegistry::getID(i));
+            entry.values[(size_t)i] = parameter.isValid() ? (float)parameter.getProperty("value")
+                                                         : ParameterRegistry::getDefault(i);
+        }
+        entries.push_back(std::move(entry));
+    }
+
+    std::sort(entries.begin(), entries.end(), [] (const Entry& a, const Entry& b)
+    {
+        return a.name.compareNatural(b.name) < 0;
+    });
+
+    // names may repeat across folders, the bank keeps the first
+    entries.erase(std::unique(entries.begin(), entries.end(), [] (const Entry& a, const Entry& b)
+    {
+        return a.name.compareNatural(b.name) == 0;
+    }), entries.end());
+
+    juce::MemoryOutputStream stringTable;
+    auto addString = [&stringTable] (const juce::String& text, juce::uint32& offset, juce::uint32& length)
+    {
+        offset = (juce::uint32)stringTable.getPosition();
+        length = (juce::uint32)text.getNumBytesAsUTF8();
+        stringTable.write(text.toRawUTF8(), length);
+    };
+
+    constexpr auto numParameters = (juce::uint32)ParameterRegistry::numParameters;
+    constexpr auto recordStride = getRecordStride(numParameters);
+
+    juce::MemoryOutputStream table;
+    for (const auto& entry : entries)
+    {
+        Record record {};
+        addString(entry.name, record.nameOffset, record.nameLength);
+        addString(entry.tags, record.tagsOffset, record.tagsLength);
+        record.modified = entry.modified;
+
+        table.write(&record, sizeof(Record));
+        table.write(entry.values.data(), sizeof(float) * entry.values.size());
+        table.writeRepeatedByte(0, recordStride - sizeof(Record) - sizeof(float) * entry.values.size());
+    }
+
+    const auto idsSize = sizeof(juce::uint32) * numParameters;
+    const auto recordsOffset = (juce::uint32)(sizeof(Header) + idsSize + 7) & ~7u;
+
+    Header bankHeader { magic, version, numParameters, (juce::uint32)entries.size(),
+                        recordsOffset, recordStride,
+                        (juce::uint32)(recordsOffset + table.getDataSize()), (juce::uint32)stringTable.getDataSize() };
+
+    juce::TemporaryFile temporary { bankFile };
+    {
+        juce::FileOutputStream stream { temporary.getFile() };
+        if (!stream.openedOk())
+            return {};
+
+        stream.write(&bankHeader, sizeof(Header));
+        stream.write(StateFormat::getIdHashes().data(), idsSize);
+        stream.writeRepeatedByte(0, recordsOffset - sizeof(Header) - idsSize);
+        stream << table << stringTable;
+        stream.flush();
+
+        if (stream.getStatus().failed())
+            return {};
+    }
+
+    auto target = bankFile;
+    if (!temporary.overwriteTargetFileWithTemporary())
+    {
+        target = bankFile.getNonexistentSibling(false);
+        if (!temporary.getFile().moveFileTo(target))
+            return {};
+    }
+
+    // an older numbered bank that is still mapped stays until the next write
+    const auto name = bankFile.getFileNameWithoutExtension();
+    for (const auto& sibling : bankFile.getParentDirectory().findChildFiles(juce::File::findFiles, false, name + "*" + bankFile.getFileExtension()))
+    {
+        const auto number = sibling.getFileNameWithoutExtension().substring(name.length());
+        if (sibling != target && number.isNotEmpty() && number.containsOnly("0123456789"))
+            sibling.deleteFile();
+    }
+    return target;
+}
@@ -0,0 +1,94 @@
+/*
+  ==============================================================================
+
+    PresetBank.h
+
+  ==============================================================================
+*/
+
+#pragma once
+#include <JuceHeader.h>
+#include "ParameterRegistry.h"
+
+// many presets in one memory-mapped file: a header, the id hash of every
+// parameter the bank stores, a table of fixed-stride records (name and tags as
+// string table offsets, the source file's time and a plain value per stored
+// parameter), then the string table. values are matched to the registry by id
+// when the bank opens, so a bank written before parameters were added still
+// loads. listing and loading read the mapping directly, nothing is parsed
+class PresetBank
+{
+public:
+    static const juce::String extension;
+
+    // maps the file, isOpen() is false when it's missing or not a bank this build can read
+    explicit PresetBank(const juce::File& file);
+
+    bool isOpen() const { return header != nullptr; }
+    const juce::File& getFile() const { return file; }
+
+    int size() const;
+    juce::String getName(int index) const;
+    juce::StringArray getTags(int index) const;
+    juce::Time getModificationTime(int index) const;
+    // every registry parameter, defaults for the ones the bank doesn't store
+    std::array<float, ParameterRegistry::numParameters> getValues(int index) const;
+
+    // records are sorted by name, -1 when it isn't in the bank
+    int indexOf(const juce::String& name) const;
+
+    // records whose name or tags contain the text, ignoring case
+    juce::Array<int> search(const juce::String& text) const;
+
+    // the record as an apvts state, the same tree a .preset file holds
+    juce::ValueTree createState(int index, const juce::Identifier& stateType) const;
+
+    // writes one record back out as a .preset file
+    bool exportPreset(int index, const juce::File& presetFile, const juce::Identifier& stateType) const;
+
+    // packs .preset files into a bank and returns the file written, or an empty
+    // file when it failed. windows won't replace a bank another instance still
+    // maps, then it goes next to it under a numbered name. the numbered banks
+    // earlier writes left behind are removed here, nowhere else
+    static juce::File write(const juce::File& bankFile, const juce::Array<juce::File>& presetFiles);
+
+    // the folder's Presets.tingebank and the ones written next to it, newest first
+    static juce::Array<juce::File> findBanks(const juce::File& directory);
+
+private:
+    struct Header
+    {
+        juce::uint32 magic, version, numParameters, numPresets;
+        juce::uint32 recordsOffset, recordStride, stringsOffset, stringsSize;
+        // numParameters id hashes follow
+    };
+
+    struct Record
+    {
+        juce::uint32 nameOffset, nameLength, tagsOffset, tagsLength;
+        juce::int64 modified;
+        // numParameters floats follow
+    };
+
+    static constexpr juce::uint32 magic = 0x4b474e54; // "TNGK"
+    static constexpr juce::uint32 version = 1;
+
+    static constexpr juce::uint32 getRecordStride(juce::uint32 numParameters)
+    {
+        return (juce::uint32)(sizeof(Record) + sizeof(float) * numParameters + 7) & ~7u;
+    }
+
+    const Record& getRecord(int index) const;
+    juce::String getString(juce::uint32 offset, juce::uint32 length) const;
+
+    juce::File file;
+    std::unique_ptr<juce::MemoryMappedFile> mapping;
+    const Header* header = nullptr;
+    const char* records = nullptr;
+    const char* strings = nullptr;
+
+    // where each registry parameter sits in a record, -1 when the bank lacks it
+    std::array<int, ParameterRegistry::numParameters> columns {};
+
+    JUCE_DECLARE_NON_COPYABLE (PresetBank)
+};
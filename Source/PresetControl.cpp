@@ -19,22 +19,25 @@ void PresetControlsLookAndFeel::drawButtonBackground (juce::Graphics& g, juce::B
     float width = bounds.getWidth();
     float height = bounds.getHeight();
 
-    switch (lookAndFeel) {
-        case PresetControlsLAF::Save:
-            drawSaveButton(g, (x + width/2) - (height/2), y, height);
-            break;
-            
-        case PresetControlsLAF::Next:
-            drawArrowButton(g, (x + width/2) - (height/2), y, height, true);
-            break;
-            
-        case PresetControlsLAF::Previous:
-            drawArrowButton(g, (x + width/2) - (height/2), y, height, false);
-            break;
-            
-        default:
-            break;
-    }
+    sprites.draw(g, button.getLocalBounds(), 0, 0.0f, 0, [&] (juce::Graphics& sprite, float)
+    {
+        switch (lookAndFeel) {
+            case PresetControlsLAF::Save:
+                drawSaveButton(sprite, (x + width/2) - (height/2), y, height);
+                break;
+                
+            case PresetControlsLAF::Next:
+                drawArrowButton(sprite, (x + width/2) - (height/2), y, height, true);
+                break;
+                
+            case PresetControlsLAF::Previous:
+                drawArrowButton(sprite, (x + width/2) - (height/2), y, height, false);
+                break;
+                
+            default:
+                break;
+        }
+    });
 }
 
 void PresetControlsLookAndFeel::setMarginAndFont(int margin, int fontSize)
@@ -158,8 +161,13 @@ PresetControlsLayout::PresetControlsLayout(TingeAudioProcessor& p, TingeAudioPro
     prevButton.setLookAndFeel(&prevLAF);
     
     addAndMakeVisible(presetComboBox);
+    // typing into it finds a preset by name or tag
+    presetComboBox.setEditableText(true);
     presetComboBox.addListener(this);
     presetComboBox.setLookAndFeel(&comboBoxLAF);
+    presetManager.getIndex().addListener(this);
+    // the selection moves before the preset arrives, a preset that can't be read moves it back
+    presetManager.onLoadFailed = [this] (const juce::String&) { showCurrentPreset(); };
     loadPresetList();
     
     addAndMakeVisible(editorSizeComboBox);
@@ -173,6 +181,7 @@ PresetControlsLayout::PresetControlsLayout(TingeAudioProcessor& p, TingeAudioPro
 
 PresetControlsLayout::~PresetControlsLayout()
 {
+    presetManager.getIndex().removeListener(this);
     saveButton.removeListener(this);
     nextButton.removeListener(this);
     prevButton.removeListener(this);
@@ -252,7 +261,32 @@ void PresetControlsLayout::resized()
 void PresetControlsLayout::comboBoxChanged(juce::ComboBox *comboBoxThatHasChanged)
 {
     if (comboBoxThatHasChanged == &presetComboBox)
-        presetManager.loadPreset(presetComboBox.getItemText(presetComboBox.getSelectedItemIndex()));
+    {
+        const auto selectedId = presetComboBox.getSelectedId();
+        if (selectedId == exportBankItemId || selectedId == importBankItemId)
+        {
+            showCurrentPreset();
+            chooseBankFile(selectedId == exportBankItemId);
+        }
+        else if (selectedId == 0)
+        {
+            // typed text that isn't a preset name loads the first preset it matches
+            const auto text = presetComboBox.getText().trim();
+            const auto matches = text.isEmpty() ? juce::Array<int>() : presetManager.getIndex().search(text);
+            if (matches.isEmpty())
+            {
+                showCurrentPreset();
+                return;
+            }
+            
+            presetComboBox.setSelectedItemIndex(matches.getFirst(), juce::dontSendNotification);
+            presetManager.loadPreset(presetManager.getIndex()[matches.getFirst()].name);
+        }
+        else
+        {
+            presetManager.loadPreset(presetComboBox.getItemText(presetComboBox.getSelectedItemIndex()));
+        }
+    }
     
  //   if (comboBoxThatHasChanged == &editorSizeComboBox)
  //       editor.changeEditorSize(editorSizeComboBox.getSelectedItemIndex());
@@ -270,19 +304,40 @@ void PresetControlsLayout::buttonClicked(juce::Button* buttonClicked)
         {
             const auto resultFile = chooser.getResult();
             presetManager.savePreset(resultFile.getFileNameWithoutExtension());
-            loadPresetList();
         });
 
     } else if (buttonClicked == &nextButton){
-        presetManager.loadNextPreset();
-        loadPresetList();
+        // the list itself only changes with the index, stepping just moves the selection
+        presetComboBox.setSelectedItemIndex(presetManager.loadNextPreset(), juce::dontSendNotification);
         
     } else if (buttonClicked == &prevButton){
-        presetManager.loadPreviousPreset();
-        loadPresetList();
+        presetComboBox.setSelectedItemIndex(presetManager.loadPreviousPreset(), juce::dontSendNotification);
     }
 }
 
+// a bank written from the loose presets, e.g. to hand a whole folder to someone,
+// or one read back out into .preset files
+void PresetControlsLayout::chooseBankFile(bool isExport)
+{
+    fileChooser = std::make_unique<juce::FileChooser>(
+        isExport ? "Export Bank" : "Import Bank",
+        presetManager.defaultDirectory.getChildFile("Presets." + PresetBank::extension),
+        "*." + PresetBank::extension);
+    
+    const auto mode = isExport ? juce::FileBrowserComponent::saveMode : juce::FileBrowserComponent::openMode;
+    fileChooser->launchAsync(mode | juce::FileBrowserComponent::canSelectFiles, [this, isExport](const juce::FileChooser& chooser)
+    {
+        const auto bankFile = chooser.getResult();
+        if (bankFile == juce::File())
+            return;
+        
+        if (isExport)
+            presetManager.writeBank(bankFile);
+        else
+            presetManager.extractBank(bankFile);
+    });
+}
+
 void PresetControlsLayout::setEditorSizeIndex(int editorSizeIndex)
 {
     std::array<juce::String, 3> editorSize = { "Small", "Medium", "Large" };
@@ -294,9 +349,21 @@ void PresetControlsLayout::loadPresetList()
 {
     presetComboBox.clear(juce::dontSendNotification);
     const auto allPresets = presetManager.getAllPreset();
-    const auto currentPreset = presetManager.getCurrentPreset();
     presetComboBox.addItemList(allPresets, 1);
+    presetComboBox.addSeparator();
+    presetComboBox.addItem("Export Bank...", exportBankItemId);
+    presetComboBox.addItem("Import Bank...", importBankItemId);
+    showCurrentPreset();
+}
+
+void PresetControlsLayout::showCurrentPreset()
+{
+    const auto currentPreset = presetManager.getCurrentPreset();
     presetComboBox.setTitle(currentPreset);
-    presetComboBox.setSelectedItemIndex(allPresets.indexOf(currentPreset), juce::dontSendNotification);
+    presetComboBox.setSelectedItemIndex(presetManager.getIndex().indexOf(currentPreset), juce::dontSendNotification);
 }
 
+void PresetControlsLayout::presetIndexChanged()
+{
+    loadPresetList();
+}
@@ -15,6 +15,7 @@
 #include "PluginProcessor.h"
 #include "PluginEditor.h"
 #include "Presets.h"
+#include "SpriteCache.h"
 
 class TingeAudioProcessor;
 class TingeAudioProcessorEditor;
@@ -47,11 +48,12 @@ public:
     
 private:
     PresetControlsLAF lookAndFeel;
+    SpriteCache sprites;
     int margin = 5;
     int fontSize = 12;
 };
 
-class PresetControlsLayout : public juce::Component, juce::ComboBox::Listener, juce::Button::Listener, GraphicsHelper
+class PresetControlsLayout : public juce::Component, juce::ComboBox::Listener, juce::Button::Listener, PresetIndex::Listener, GraphicsHelper
 {
 public:
     PresetControlsLayout(TingeAudioProcessor& p, TingeAudioProcessorEditor& e, juce::AudioProcessorValueTreeState& apvts);
@@ -66,6 +68,14 @@ public:
     void loadPresetList();
     
 private:
+    void presetIndexChanged() override;
+    void showCurrentPreset();
+    void chooseBankFile(bool isExport);
+    
+    // after the presets in the list, ids no preset position reaches
+    static constexpr int exportBankItemId = std::numeric_limits<int>::max();
+    static constexpr int importBankItemId = exportBankItemId - 1;
+    
     PresetControlsLookAndFeel saveLAF { PresetControlsLAF::Save },
     nextLAF { PresetControlsLAF::Next },
     prevLAF { PresetControlsLAF::Previous },
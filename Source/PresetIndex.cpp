@@ -0,0 +1,211 @@
+/*
+  ==============================================================================
+
+    PresetIndex.cpp
+
+  ==============================================================================
+*/
+
+#include "PresetIndex.h"
+
+const juce::Identifier PresetIndex::tagsAttribute { "tags" };
+
+PresetIndex::PresetIndex(const juce::File& directory, const juce::String& extension)
+: directory(directory), wildcard("*." + extension)
+{
+    thread->addTimeSliceClient(this);
+}
+
+PresetIndex::~PresetIndex()
+{
+    thread->removeTimeSliceClient(this);
+    cancelPendingUpdate();
+}
+
+int PresetIndex::indexOf(const juce::String& name) const
+{
+    return positions.contains(name) ? positions[name] : -1;
+}
+
+juce::Array<int> PresetIndex::search(const juce::String& text) const
+{
+    juce::Array<int> matches;
+    const PresetBank* searchedBank = nullptr;
+    std::set<int> bankMatches;
+
+    for (int i = 0; i < size(); i++)
+    {
+        const auto& entry = entries[(size_t)i];
+
+        // bank presets are matched in the mapping, in one pass over its records
+        if (entry.bank != nullptr)
+        {
+            if (entry.bank.get() != searchedBank)
+            {
+                searchedBank = entry.bank.get();
+                const auto found = searchedBank->search(text);
+                bankMatches = std::set<int>(found.begin(), found.end());
+            }
+
+            if (bankMatches.count(entry.bankIndex) > 0)
+                matches.add(i);
+        }
+        else if (entry.name.containsIgnoreCase(text) || entry.tags.joinIntoString(",").containsIgnoreCase(text))
+        {
+            matches.add(i);
+        }
+    }
+    return matches;
+}
+
+void PresetIndex::refresh()
+{
+    rescanRequested = true;
+    thread->moveToFrontOfQueue(this);
+}
+
+int PresetIndex::useTimeSlice()
+{
+    if (iterator == nullptr)
+    {
+        rescanRequested = false;
+        found.clear();
+        bankChanged = updateBank();
+        iterator = std::make_unique<juce::RangedDirectoryIterator>(directory, false, wildcard,
+                                                                    juce::File::findFiles);
+    }
+
+    auto& files = *iterator;
+    for (int i = 0; i < filesPerSlice && files != juce::RangedDirectoryIterator(); i++, ++files)
+    {
+        const auto& entry = *files;
+        const auto path = entry.getFile().getFullPathName();
+        const auto modified = entry.getModificationTime();
+
+        // unchanged presets keep what was parsed last time
+        auto previous = known.find(path);
+        if (previous != known.end() && previous->second.modified == modified)
+            found.emplace(path, std::move(previous->second));
+        else
+            found.emplace(path, readPreset(entry.getFile(), modified));
+    }
+
+    if (files != juce::RangedDirectoryIterator())
+    {
+        // the first walk shows what it has so far, stepping through presets works before it ends
+        if (!published)
+            publish(found);
+
+        return 0;
+    }
+
+    iterator.reset();
+    finishScan();
+    return rescanRequested ? 0 : pollIntervalMs;
+}
+
+PresetInfo PresetIndex::readPreset(const juce::File& file, juce::Time modified) const
+{
+    PresetInfo info { file.getFileNameWithoutExtension(), file, modified, {} };
+
+    // only the outer element is read for the tags, the parameters aren't parsed
+    juce::XmlDocument document { file };
+    if (auto root = document.getDocumentElement(true))
+        info.tags.addTokens(root->getStringAttribute(tagsAttribute), ",", "\"");
+
+    info.tags.trim();
+    info.tags.removeEmptyStrings();
+    return info;
+}
+
+bool PresetIndex::updateBank()
+{
+    const auto banks = PresetBank::findBanks(directory);
+    const auto newest = banks.isEmpty() ? juce::File() : banks.getFirst();
+    const auto modified = newest.existsAsFile() ? newest.getLastModificationTime() : juce::Time();
+
+    if (newest == bankFile && modified == bankModified)
+        return false;
+
+    // readers still holding the old mapping keep it alive until they let go
+    bankFile = newest;
+    bankModified = modified;
+    auto newBank = newest.existsAsFile() ? std::make_shared<const PresetBank>(newest) : nullptr;
+    bank = newBank != nullptr && newBank->isOpen() ? std::move(newBank) : nullptr;
+    return true;
+}
+
+void PresetIndex::finishScan()
+{
+    const bool changed = bankChanged || found.size() != known.size()
+        || !std::equal(found.begin(), found.end(), known.begin(), [] (const auto& a, const auto& b)
+                       {
+                           return a.first == b.first && a.second.modified == b.second.modified;
+                       });
+
+    // the moved-from entries left in known are dropped here
+    known = std::move(found);
+    found.clear();
+
+    if (!changed && published)
+        return;
+
+    published = true;
+    publish(known);
+}
+
+void PresetIndex::publish(const std::map<juce::String, PresetInfo>& loose)
+{
+    auto index = std::make_unique<std::vector<PresetInfo>>();
+    index->reserve(loose.size() + (size_t)(bank != nullptr ? bank->size() : 0));
+    
+    std::set<juce::String> looseNames;
+    for (const auto& [path, info] : loose)
+    {
+        index->push_back(info);
+        looseNames.insert(info.name);
+    }
+    
+    if (bank != nullptr)
+    {
+        for (int i = 0; i < bank->size(); i++)
+        {
+            auto name = bank->getName(i);
+            if (looseNames.count(name) == 0)
+                index->push_back({ name, bank->getFile(), bank->getModificationTime(i), bank->getTags(i), bank, i });
+        }
+    }
+
+    std::sort(index->begin(), index->end(), [] (const PresetInfo& a, const PresetInfo& b)
+    {
+        return a.name.compareNatural(b.name) < 0;
+    });
+
+    {
+        const juce::ScopedLock lock(pendingLock);
+        pending = std::move(index);
+    }
+    triggerAsyncUpdate();
+}
+
+void PresetIndex::handleAsyncUpdate()
+{
+    {
+        const juce::ScopedLock lock(pendingLock);
+        if (pending == nullptr)
+            return;
+
+        entries = std::move(*pending);
+        pending.reset();
+    }
+
+    names.clearQuick();
+    positions.clear();
+    for (int i = 0; i < size(); i++)
+    {
+        names.add(entries[(size_t)i].name);
+        positions.set(entries[(size_t)i].name, i);
+    }
+
+    listeners.call([] (Listener& l) { l.presetIndexChanged(); });
+}
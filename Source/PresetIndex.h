@@ -0,0 +1,107 @@
+/*
+  ==============================================================================
+
+    PresetIndex.h
+
+  ==============================================================================
+*/
+
+#pragma once
+#include <JuceHeader.h>
+#include "PresetBank.h"
+
+struct PresetInfo
+{
+    juce::String name;
+    juce::File file;
+    juce::Time modified;
+    juce::StringArray tags;
+
+    // set for presets that live in the bank rather than their own file
+    std::shared_ptr<const PresetBank> bank;
+    int bankIndex = -1;
+};
+
+// the one background thread preset scanning and loading share between instances
+struct PresetThread : juce::TimeSliceThread
+{
+    PresetThread() : juce::TimeSliceThread("Preset worker") { startThread(juce::Thread::Priority::background); }
+    ~PresetThread() override { stopThread(2000); }
+};
+
+// sorted in-memory list of the preset folder. a background thread walks the
+// folder a few files at a time, only re-reads presets whose modification time
+// moved, and hands a finished index to the message thread. the first walk also
+// hands over what it has found after every slice. the folder's bank
+// is mapped and its presets listed too, a loose file wins over a bank preset
+// of the same name, and of banks written next to each other the newest is listed.
+// every lookup here is message thread only and never touches the disk
+class PresetIndex : private juce::TimeSliceClient, private juce::AsyncUpdater
+{
+public:
+    struct Listener
+    {
+        virtual ~Listener() = default;
+        virtual void presetIndexChanged() = 0;
+    };
+
+    PresetIndex(const juce::File& directory, const juce::String& extension);
+    ~PresetIndex() override;
+
+    int size() const { return (int)entries.size(); }
+    const PresetInfo& operator[](int index) const { return entries[(size_t)index]; }
+
+    // -1 when the preset isn't in the index
+    int indexOf(const juce::String& name) const;
+    const juce::StringArray& getNames() const { return names; }
+
+    // positions of the presets whose name or tags contain the text, ignoring case
+    juce::Array<int> search(const juce::String& text) const;
+
+    // rescan as soon as possible, e.g. after saving a preset
+    void refresh();
+
+    void addListener(Listener* listener) { listeners.add(listener); }
+    void removeListener(Listener* listener) { listeners.remove(listener); }
+
+    // the root attribute a preset file lists its tags in, comma separated
+    static const juce::Identifier tagsAttribute;
+
+private:
+    int useTimeSlice() override;
+    void handleAsyncUpdate() override;
+
+    PresetInfo readPreset(const juce::File& file, juce::Time modified) const;
+    bool updateBank();
+    void finishScan();
+    void publish(const std::map<juce::String, PresetInfo>& loose);
+
+    // files looked at per slice, so a removed client never waits on a whole walk
+    static constexpr int filesPerSlice = 64;
+    static constexpr int pollIntervalMs = 5000;
+
+    const juce::File directory;
+    const juce::String wildcard;
+
+    // scan thread
+    std::unique_ptr<juce::RangedDirectoryIterator> iterator;
+    std::map<juce::String, PresetInfo> known, found;
+    std::atomic<bool> rescanRequested { false };
+    bool published = false, bankChanged = false;
+    std::shared_ptr<const PresetBank> bank;
+    juce::File bankFile;
+    juce::Time bankModified;
+
+    juce::CriticalSection pendingLock;
+    std::unique_ptr<std::vector<PresetInfo>> pending;
+
+    // message thread
+    std::vector<PresetInfo> entries;
+    juce::StringArray names;
+    juce::HashMap<juce::String, int> positions;
+    juce::ListenerList<Listener> listeners;
+
+    juce::SharedResourcePointer<PresetThread> thread;
+
+    JUCE_DECLARE_NON_COPYABLE (PresetIndex)
+};
@@ -0,0 +1,160 @@
+/*
+  ==============================================================================
+
+    PresetLoader.cpp
+
+  ==============================================================================
+*/
+
+#include "PresetLoader.h"
+
+PresetLoader::PresetLoader()
+{
+    thread->addTimeSliceClient(this);
+}
+
+PresetLoader::~PresetLoader()
+{
+    thread->removeTimeSliceClient(this);
+    cancelPendingUpdate();
+}
+
+void PresetLoader::request(const PresetInfo& preset)
+{
+    Parsed ready;
+    bool isReady = false;
+    {
+        const juce::ScopedLock sl(lock);
+        const int index = findParsed(preset.file, preset.modified);
+
+        if (index < 0)
+        {
+            wantedPath = preset.file.getFullPathName();
+            jobs.push_front({ preset.file, preset.modified, preset.name });
+        }
+        else
+        {
+            wantedPath.clear();
+            ready = std::move(parsed[(size_t)index]);
+            parsed.erase(parsed.begin() + index);
+            isReady = true;
+        }
+    }
+
+    if (isReady)
+    {
+        deliver(ready);
+        return;
+    }
+
+    thread->moveToFrontOfQueue(this);
+}
+
+void PresetLoader::prefetch(const PresetInfo& preset)
+{
+    {
+        const juce::ScopedLock sl(lock);
+        if (findParsed(preset.file, preset.modified) >= 0)
+            return;
+
+        jobs.push_back({ preset.file, preset.modified, preset.name });
+    }
+    thread->moveToFrontOfQueue(this);
+}
+
+void PresetLoader::cancel()
+{
+    const juce::ScopedLock sl(lock);
+    wantedPath.clear();
+}
+
+juce::ValueTree PresetLoader::read(const juce::File& file)
+{
+    juce::XmlDocument xmlDocument { file };
+    if (auto xml = xmlDocument.getDocumentElement())
+        return juce::ValueTree::fromXml(*xml);
+
+    return {};
+}
+
+int PresetLoader::useTimeSlice()
+{
+    Job job;
+    {
+        const juce::ScopedLock sl(lock);
+        if (jobs.empty())
+            return idleWaitMs;
+
+        job = jobs.front();
+        jobs.pop_front();
+
+        if (findParsed(job.file, job.modified) >= 0)
+            return 0;
+    }
+
+    // the slow part, outside the lock. a broken file is kept as a failure until
+    // its modification time moves, so it isn't parsed again on every step
+    auto state = read(job.file);
+
+    bool isWanted;
+    {
+        const juce::ScopedLock sl(lock);
+        if ((int)parsed.size() >= maxParsed)
+            parsed.pop_front();
+
+        parsed.push_back({ job.file.getFullPathName(), job.modified, job.name, std::move(state) });
+        isWanted = job.file.getFullPathName() == wantedPath;
+    }
+
+    if (isWanted)
+        triggerAsyncUpdate();
+
+    return 0;
+}
+
+void PresetLoader::handleAsyncUpdate()
+{
+    Parsed ready;
+    bool isReady = false;
+    {
+        const juce::ScopedLock sl(lock);
+        for (auto it = parsed.begin(); it != parsed.end(); ++it)
+        {
+            if (it->path == wantedPath)
+            {
+                ready = std::move(*it);
+                parsed.erase(it);
+                isReady = true;
+                break;
+            }
+        }
+        wantedPath.clear();
+    }
+
+    if (isReady)
+        deliver(ready);
+}
+
+void PresetLoader::deliver(const Parsed& ready)
+{
+    if (ready.state.isValid())
+    {
+        if (onLoaded != nullptr)
+            onLoaded(ready.name, ready.state);
+    }
+    else if (onFailed != nullptr)
+    {
+        onFailed(ready.name);
+    }
+}
+
+int PresetLoader::findParsed(const juce::File& file, juce::Time modified) const
+{
+    const auto path = file.getFullPathName();
+    for (size_t i = 0; i < parsed.size(); i++)
+    {
+        if (parsed[i].path == path && parsed[i].modified == modified)
+            return (int)i;
+    }
+    return -1;
+}
@@ -0,0 +1,73 @@
+/*
+  ==============================================================================
+
+    PresetLoader.h
+
+  ==============================================================================
+*/
+
+#pragma once
+#include <JuceHeader.h>
+#include "PresetIndex.h"
+
+// reads and parses presets on the preset thread into ready ValueTrees. the
+// preset asked for last is handed back on the message thread, older requests
+// and prefetches stay parsed so stepping onto them is immediate
+class PresetLoader : private juce::TimeSliceClient, private juce::AsyncUpdater
+{
+public:
+    PresetLoader();
+    ~PresetLoader() override;
+
+    // message thread, called synchronously when the preset is already parsed.
+    // the tree is handed over, the loader keeps no reference to it
+    std::function<void(const juce::String& name, const juce::ValueTree& state)> onLoaded;
+    // message thread, when the requested preset can't be parsed
+    std::function<void(const juce::String& name)> onFailed;
+
+    // supersedes any earlier request that hasn't arrived yet
+    void request(const PresetInfo& preset);
+    void prefetch(const PresetInfo& preset);
+
+    // drops the pending request, e.g. when a preset was applied some other way
+    void cancel();
+
+    // parses on the calling thread, for presets the index doesn't know yet
+    static juce::ValueTree read(const juce::File& file);
+
+private:
+    struct Job
+    {
+        juce::File file;
+        juce::Time modified;
+        juce::String name;
+    };
+
+    struct Parsed
+    {
+        juce::String path;
+        juce::Time modified;
+        juce::String name;
+        juce::ValueTree state; // invalid when the file didn't parse
+    };
+
+    int useTimeSlice() override;
+    void handleAsyncUpdate() override;
+    void deliver(const Parsed& ready);
+
+    // lock held
+    int findParsed(const juce::File& file, juce::Time modified) const;
+
+    // the asked-for preset plus a neighbour either side, with room to spare
+    static constexpr int maxParsed = 6;
+    static constexpr int idleWaitMs = 1000;
+
+    juce::CriticalSection lock;
+    std::deque<Job> jobs;
+    std::deque<Parsed> parsed;
+    juce::String wantedPath;
+
+    juce::SharedResourcePointer<PresetThread> thread;
+
+    JUCE_DECLARE_NON_COPYABLE (PresetLoader)
+};
@@ -19,6 +19,10 @@ const juce::File PresetManager::defaultDirectory { juce::File::getSpecialLocatio
 const juce::String PresetManager::extension { "preset" };
 const juce::String PresetManager::presetNameProperty { "presetName" };
 
+SharedPresetIndex::SharedPresetIndex() : PresetIndex(PresetManager::defaultDirectory, PresetManager::extension)
+{
+}
+
 PresetManager::PresetManager(juce::AudioProcessorValueTreeState& apvts) : apvts(apvts)
 {
     if(!defaultDirectory.exists())
@@ -32,10 +36,21 @@ PresetManager::PresetManager(juce::AudioProcessorValueTreeState& apvts) : apvts(
     
     apvts.state.addListener(this);
     currentPreset.referTo(apvts.state.getPropertyAsValue(presetNameProperty, nullptr));
+    
+    loader.onLoaded = [this] (const juce::String& presetName, const juce::ValueTree& state)
+    {
+        applyPreset(presetName, state);
+    };
+    loader.onFailed = [this] (const juce::String& presetName)
+    {
+        presetFailed(presetName);
+    };
+    index.addListener(this);
 }
 
 PresetManager::~PresetManager()
 {
+    index.removeListener(this);
     apvts.state.removeListener(this);
 }
 
@@ -43,6 +58,27 @@ void PresetManager::loadPreset(const juce::String& presetName)
 {
     if (presetName.isEmpty())
         return;
+    
+    const auto position = index.indexOf(presetName);
+    
+    // bank presets are read straight from the mapping
+    if (position >= 0 && index[position].bank != nullptr)
+    {
+        const auto& preset = index[position];
+        loader.cancel();
+        applyPreset(presetName, preset.bank->createState(preset.bankIndex, apvts.state.getType()));
+        return;
+    }
+    
+    // parsed on the preset thread, the state swap and the name change happen when it arrives
+    if (position >= 0)
+    {
+        requestedPreset = presetName;
+        loader.request(index[position]);
+        return;
+    }
+    
+    // not indexed yet, e.g. saved a moment ago
     const auto presetFile = defaultDirectory.getChildFile(presetName + "." + extension);
     if (!presetFile.existsAsFile())
     {
@@ -51,11 +87,77 @@ void PresetManager::loadPreset(const juce::String& presetName)
         return;
     }
     
-    juce::XmlDocument xmlDocument { presetFile };
-    const auto valueTreeToLoad = juce::ValueTree::fromXml(*xmlDocument.getDocumentElement());
-    
-    apvts.replaceState(valueTreeToLoad);
+    // an earlier request still on its way mustn't land on top of this one
+    loader.cancel();
+    requestedPreset.clear();
+    const auto valueTreeToLoad = PresetLoader::read(presetFile);
+    if (valueTreeToLoad.isValid())
+        applyPreset(presetName, valueTreeToLoad);
+    else
+        presetFailed(presetName);
+}
+
+void PresetManager::applyPreset(const juce::String& presetName, const juce::ValueTree& state)
+{
+    apvts.replaceState(state);
     currentPreset.setValue(presetName);
+    requestedPreset.clear();
+    prefetchNeighbours(index.indexOf(presetName));
+}
+
+void PresetManager::presetFailed(const juce::String& presetName)
+{
+    DBG("Could not read preset: " + presetName);
+    
+    // stepping goes on from the preset that's actually loaded
+    requestedPreset.clear();
+    if (onLoadFailed != nullptr)
+        onLoadFailed(presetName);
+}
+
+void PresetManager::prefetchNeighbours(int position)
+{
+    const auto numPresets = index.size();
+    if (position < 0 || numPresets < 2)
+        return;
+    
+    // bank presets need no prefetch
+    for (auto neighbour : { position + 1, position + numPresets - 1 })
+    {
+        const auto& preset = index[neighbour % numPresets];
+        if (preset.bank == nullptr)
+            loader.prefetch(preset);
+    }
+}
+
+bool PresetManager::writeBank(const juce::File& bankFile)
+{
+    juce::Array<juce::File> presetFiles;
+    for (int i = 0; i < index.size(); i++)
+    {
+        if (index[i].bank == nullptr)
+            presetFiles.add(index[i].file);
+    }
+    
+    const bool written = PresetBank::write(bankFile, presetFiles) != juce::File();
+    index.refresh();
+    return written;
+}
+
+int PresetManager::extractBank(const juce::File& bankFile)
+{
+    const PresetBank bank { bankFile };
+    int numWritten = 0;
+    
+    for (int i = 0; i < bank.size(); i++)
+    {
+        const auto presetFile = defaultDirectory.getChildFile(juce::File::createLegalFileName(bank.getName(i)) + "." + extension);
+        if (bank.exportPreset(i, presetFile, apvts.state.getType()))
+            numWritten++;
+    }
+    
+    index.refresh();
+    return numWritten;
 }
 
 void PresetManager::savePreset(const juce::String& presetName)
@@ -71,42 +173,35 @@ void PresetManager::savePreset(const juce::String& presetName)
         DBG("Could not create preset file: " + presetFile.getFullPathName());
         jassertfalse;
     }
+    index.refresh();
 }
 
 int PresetManager::loadNextPreset()
 {
-    const auto allPresets = getAllPreset();
-    if (allPresets.isEmpty())
+    if (index.size() == 0)
         return -1;
     
-    const auto currentIndex = allPresets.indexOf(currentPreset.toString());
-    const auto nextIndex = currentIndex + 1 > (allPresets.size() - 1) ? 0 : currentIndex + 1;
-    loadPreset(allPresets.getReference(nextIndex));
+    const auto currentIndex = index.indexOf(getSteppingPreset());
+    const auto nextIndex = currentIndex + 1 > (index.size() - 1) ? 0 : currentIndex + 1;
+    loadPreset(index[nextIndex].name);
     return nextIndex;
 }
                                
 int PresetManager::loadPreviousPreset()
 {
-    const auto allPresets = getAllPreset();
-    if (allPresets.isEmpty())
+    if (index.size() == 0)
         return -1;
     
-    const auto currentIndex = allPresets.indexOf(currentPreset.toString());
-    const auto previousIndex = currentIndex - 1 < 0 ? allPresets.size() - 1 : currentIndex - 1;
-    loadPreset(allPresets.getReference(previousIndex));
+    const auto currentIndex = index.indexOf(getSteppingPreset());
+    const auto previousIndex = currentIndex - 1 < 0 ? index.size() - 1 : currentIndex - 1;
+    loadPreset(index[previousIndex].name);
     return previousIndex;
 }
 
+// whatever the background scan last published, never walks the folder
 juce::StringArray PresetManager::getAllPreset() const
 {
-    juce::StringArray presets;
-    const auto fileArray = defaultDirectory.findChildFiles(juce::File::TypesOfFileToFind::findFiles, false, "*.preset");
-    
-    for (const auto& file : fileArray)
-    {
-        presets.add(file.getFileNameWithoutExtension());
-    }
-    return presets;
+    return index.getNames();
 }
 
 juce::String PresetManager::getCurrentPreset() const
@@ -114,7 +209,19 @@ juce::String PresetManager::getCurrentPreset() const
     return currentPreset.toString();
 }
 
+// quick steps go on from the preset asked for last, even before it has arrived
+juce::String PresetManager::getSteppingPreset() const
+{
+    return requestedPreset.isNotEmpty() ? requestedPreset : currentPreset.toString();
+}
+
 void PresetManager::valueTreeRedirected(juce::ValueTree &treeWhichHasBeenChanged)
 {
     currentPreset.referTo(treeWhichHasBeenChanged.getPropertyAsValue(presetNameProperty, nullptr));
 }
+
+void PresetManager::presetIndexChanged()
+{
+    // so the first step from the current preset doesn't wait on the disk
+    prefetchNeighbours(index.indexOf(currentPreset.toString()));
+}
@@ -10,8 +10,18 @@
 
 #pragma once
 #include <JuceHeader.h>
+#include "PresetIndex.h"
+#include "PresetLoader.h"
 
-class PresetManager : juce::ValueTree::Listener
+// the preset folder's index, one per process. every instance's processor holds
+// it, so a reopened editor finds the folder already scanned and the folder is
+// polled once however many editors are open
+struct SharedPresetIndex : PresetIndex
+{
+    SharedPresetIndex();
+};
+
+class PresetManager : juce::ValueTree::Listener, PresetIndex::Listener
 {
 public:
     static const juce::File defaultDirectory;
@@ -27,12 +37,30 @@ public:
     int loadPreviousPreset();
     juce::StringArray getAllPreset() const;
     juce::String getCurrentPreset() const;
+    PresetIndex& getIndex() { return index; }
+    
+    // called when a preset turns out to be unreadable, the current preset stays as it was
+    std::function<void(const juce::String& presetName)> onLoadFailed;
+    
+    // packs the folder's loose presets into a bank, e.g. Presets.tingebank in the preset folder
+    bool writeBank(const juce::File& bankFile);
+    // writes every preset in a bank out as its own preset file, returns how many
+    int extractBank(const juce::File& bankFile);
     
 private:
     void valueTreeRedirected(juce::ValueTree &treeWhichHasBeenChanged) override;
+    void presetIndexChanged() override;
+    void applyPreset(const juce::String& presetName, const juce::ValueTree& state);
+    void presetFailed(const juce::String& presetName);
+    void prefetchNeighbours(int position);
+    juce::String getSteppingPreset() const;
     
     juce::AudioProcessorValueTreeState& apvts;
     juce::Value currentPreset;
+    juce::String requestedPreset;
+    juce::SharedResourcePointer<SharedPresetIndex> sharedIndex;
+    PresetIndex& index { *sharedIndex };
+    PresetLoader loader;
 };
 
 
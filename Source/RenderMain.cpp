@@ -0,0 +1,298 @@
+/*
+  ==============================================================================
+
+    RenderMain.cpp
+
+  ==============================================================================
+*/
+
+#include <JuceHeader.h>
+#include "PluginProcessor.h"
+#include "PresetBank.h"
+#include "PresetLoader.h"
+#include "Presets.h"
+
+// headless render: plays a midi file through the processor offline, block by
+// block with no audio device and no editor, and writes what comes out to a
+// new midi file. built by TingeRender.jucer from the same sources as the plugin
+namespace
+{
+    constexpr int ticksPerQuarterNote = 960;
+    constexpr double outputSecondsPerQuarterNote = 0.5; // the output file is written at 120 bpm
+
+    struct Options
+    {
+        juce::File midiIn, midiOut;
+        juce::String preset;
+        double sampleRate = 48000.0;
+        int blockSize = 512;
+        double tail = 1.0;
+        double bpm = 0.0; // 0 follows the input file's tempo map
+    };
+
+    // a playing transport at the input's tempo, so synced rates render as they would in a host
+    class RenderPlayHead : public juce::AudioPlayHead
+    {
+    public:
+        RenderPlayHead(const juce::MidiMessageSequence& sequence, double bpm, double sampleRate) : sampleRate(sampleRate)
+        {
+            if (bpm > 0.0)
+            {
+                tempos.push_back({ 0.0, 0.0, 60.0 / bpm });
+                return;
+            }
+
+            // midi files start at 120 bpm until told otherwise
+            tempos.push_back({ 0.0, 0.0, 0.5 });
+            for (const auto* event : sequence)
+            {
+                if (!event->message.isTempoMetaEvent())
+                    continue;
+
+                const auto& previous = tempos.back();
+                const auto seconds = event->message.getTimeStamp();
+                const auto ppq = previous.ppq + (seconds - previous.seconds) / previous.secondsPerQuarterNote;
+
+                if (seconds <= previous.seconds)
+                    tempos.pop_back();
+                tempos.push_back({ seconds, ppq, event->message.getTempoSecondsPerQuarterNote() });
+            }
+        }
+
+        void setPosition(juce::int64 samples) { position = samples; }
+
+        juce::Optional<PositionInfo> getPosition() const override
+        {
+            const auto seconds = (double)position / sampleRate;
+            auto tempo = tempos.begin();
+            while (std::next(tempo) != tempos.end() && std::next(tempo)->seconds <= seconds)
+                ++tempo;
+
+            PositionInfo info;
+            info.setIsPlaying(true);
+            info.setTimeInSamples(position);
+            info.setTimeInSeconds(seconds);
+            info.setBpm(60.0 / tempo->secondsPerQuarterNote);
+            info.setPpqPosition(tempo->ppq + (seconds - tempo->seconds) / tempo->secondsPerQuarterNote);
+            return info;
+        }
+
+    private:
+        struct Tempo
+        {
+            double seconds, ppq, secondsPerQuarterNote;
+        };
+
+        std::vector<Tempo> tempos;
+        double sampleRate;
+        juce::int64 position = 0;
+    };
+
+    void printUsage()
+    {
+        std::cout << "usage: TingeRender --midi <in.mid> --out <out.mid> [--preset <file or name>]\n"
+                     "                   [--rate <sample rate>] [--block <block size>] [--tail <seconds>] [--bpm <tempo>]\n"
+                     "       TingeRender --pack-bank <preset folder>\n"
+                     "a preset name is looked up in the preset folder and its bank,\n"
+                     "without --bpm synced rates follow the input file's tempo" << std::endl;
+    }
+
+    bool parseOptions(const juce::ArgumentList& args, Options& options)
+    {
+        if (!args.containsOption("--midi") || !args.containsOption("--out"))
+            return false;
+
+        options.midiIn = args.getFileForOption("--midi");
+        options.midiOut = args.getFileForOption("--out");
+        options.preset = args.getValueForOption("--preset");
+
+        if (args.containsOption("--rate"))
+            options.sampleRate = args.getValueForOption("--rate").getDoubleValue();
+        if (args.containsOption("--block"))
+            options.blockSize = args.getValueForOption("--block").getIntValue();
+        if (args.containsOption("--tail"))
+            options.tail = args.getValueForOption("--tail").getDoubleValue();
+        if (args.containsOption("--bpm"))
+            options.bpm = args.getValueForOption("--bpm").getDoubleValue();
+
+        return options.sampleRate > 0.0 && options.blockSize > 0 && options.tail >= 0.0 && options.bpm >= 0.0;
+    }
+
+    // a .preset file, or a name from the preset folder where a loose file wins over the bank
+    juce::ValueTree readPreset(const juce::String& preset, const juce::Identifier& stateType)
+    {
+        const auto file = juce::File::getCurrentWorkingDirectory().getChildFile(preset);
+        if (file.existsAsFile())
+            return PresetLoader::read(file);
+
+        const auto looseFile = PresetManager::defaultDirectory.getChildFile(preset + "." + PresetManager::extension);
+        if (looseFile.existsAsFile())
+            return PresetLoader::read(looseFile);
+
+        const auto banks = PresetBank::findBanks(PresetManager::defaultDirectory);
+        if (banks.isEmpty())
+            return {};
+
+        const PresetBank bank { banks.getFirst() };
+        const int index = bank.indexOf(preset);
+        return index >= 0 ? bank.createState(index, stateType) : juce::ValueTree();
+    }
+
+    // every .preset file in the folder into its bank, e.g. factory presets for an installer
+    int packBank(const juce::File& directory)
+    {
+        const auto presetFiles = directory.findChildFiles(juce::File::findFiles, false, "*." + PresetManager::extension);
+        const auto bankFile = PresetBank::write(directory.getChildFile("Presets." + PresetBank::extension), presetFiles);
+
+        if (bankFile == juce::File())
+        {
+            std::cerr << "can't write a bank in " << directory.getFullPathName() << std::endl;
+            return 1;
+        }
+
+        std::cout << "packed " << presetFiles.size() << " presets into " << bankFile.getFullPathName() << std::endl;
+        return 0;
+    }
+
+    juce::MidiMessageSequence readMidi(const juce::File& file)
+    {
+        juce::MidiMessageSequence sequence;
+        juce::FileInputStream stream { file };
+        juce::MidiFile midiFile;
+
+        if (!stream.openedOk() || !midiFile.readFrom(stream))
+            return sequence;
+
+        midiFile.convertTimestampTicksToSeconds();
+        for (int track = 0; track < midiFile.getNumTracks(); track++)
+            sequence.addSequence(*midiFile.getTrack(track), 0.0);
+
+        sequence.updateMatchedPairs();
+        return sequence;
+    }
+
+    bool writeMidi(const juce::File& file, juce::MidiMessageSequence& sequence)
+    {
+        sequence.addEvent(juce::MidiMessage::tempoMetaEvent((int)(outputSecondsPerQuarterNote * 1000000.0)), 0.0);
+        sequence.sort();
+        sequence.updateMatchedPairs();
+
+        juce::MidiFile midiFile;
+        midiFile.setTicksPerQuarterNote(ticksPerQuarterNote);
+        midiFile.addTrack(sequence);
+
+        juce::TemporaryFile temporary { file };
+        {
+            juce::FileOutputStream stream { temporary.getFile() };
+            if (!stream.openedOk() || !midiFile.writeTo(stream))
+                return false;
+        }
+        return temporary.overwriteTargetFileWithTemporary();
+    }
+}
+
+int main (int argc, char* argv[])
+{
+    const juce::ScopedJuceInitialiser_GUI juceInitialiser;
+    const juce::ArgumentList args { argc, argv };
+
+    if (args.containsOption("--pack-bank"))
+        return packBank(args.getFileForOption("--pack-bank"));
+
+    Options options;
+    if (!parseOptions(args, options))
+    {
+        printUsage();
+        return 1;
+    }
+
+    if (!options.midiIn.existsAsFile())
+    {
+        std::cerr << "can't find " << options.midiIn.getFullPathName() << std::endl;
+        return 1;
+    }
+
+    auto input = readMidi(options.midiIn);
+    if (input.getNumEvents() == 0)
+    {
+        std::cerr << "no midi events in " << options.midiIn.getFullPathName() << std::endl;
+        return 1;
+    }
+
+    RenderPlayHead playHead { input, options.bpm, options.sampleRate };
+    TingeAudioProcessor processor;
+    processor.setPlayHead(&playHead);
+    processor.setNonRealtime(true);
+    processor.setPlayConfigDetails(2, 2, options.sampleRate, options.blockSize);
+
+    // the preset goes in before prepareToPlay so the smoothed parameters start on it
+    if (options.preset.isNotEmpty())
+    {
+        auto& apvts = processor.params->apvts;
+        const auto state = readPreset(options.preset, apvts.state.getType());
+        if (!state.isValid() || !state.hasType(apvts.state.getType()))
+        {
+            std::cerr << "can't read preset " << options.preset << std::endl;
+            return 1;
+        }
+        apvts.replaceState(state);
+    }
+
+    processor.prepareToPlay(options.sampleRate, options.blockSize);
+
+    const auto lengthInSamples = (juce::int64)std::ceil((input.getEndTime() + options.tail) * options.sampleRate);
+    juce::AudioBuffer<float> buffer { 2, options.blockSize };
+    // reserved like a host's buffer, the processor hands each block's output over into it
+    juce::MidiBuffer midi;
+    midi.ensureSize(MIDIProcessor<numSpinners>::reservedOutputBytes);
+    juce::MidiMessageSequence output;
+    int nextEvent = 0;
+
+    const auto startTime = juce::Time::getMillisecondCounterHiRes();
+
+    for (juce::int64 blockStart = 0; blockStart < lengthInSamples; blockStart += options.blockSize)
+    {
+        const int numSamples = (int)std::min((juce::int64)options.blockSize, lengthInSamples - blockStart);
+        buffer.setSize(2, numSamples, false, false, true);
+        buffer.clear();
+        midi.clear();
+
+        // input events land on their own sample inside the block
+        for (; nextEvent < input.getNumEvents(); nextEvent++)
+        {
+            const auto& message = input.getEventPointer(nextEvent)->message;
+            const auto position = (juce::int64)std::llround(message.getTimeStamp() * options.sampleRate);
+            if (position >= blockStart + numSamples)
+                break;
+
+            if (!message.isMetaEvent())
+                midi.addEvent(message, (int)(position - blockStart));
+        }
+
+        playHead.setPosition(blockStart);
+        processor.processBlock(buffer, midi);
+
+        for (const auto metadata : midi)
+        {
+            const auto seconds = (double)(blockStart + metadata.samplePosition) / options.sampleRate;
+            output.addEvent(metadata.getMessage(), seconds / outputSecondsPerQuarterNote * ticksPerQuarterNote);
+        }
+    }
+
+    processor.releaseResources();
+
+    const auto elapsed = (juce::Time::getMillisecondCounterHiRes() - startTime) / 1000.0;
+    const auto rendered = (double)lengthInSamples / options.sampleRate;
+    const int numEvents = output.getNumEvents();
+
+    if (!writeMidi(options.midiOut, output))
+    {
+        std::cerr << "can't write " << options.midiOut.getFullPathName() << std::endl;
+        return 1;
+    }
+
+    std::cout << "rendered " << rendered << " s in " << elapsed << " s ("
+              << (elapsed > 0.0 ? rendered / elapsed : 0.0) << "x real time), "
+              << numEvents << " events to " << options.midiOut.getFullPathName() << std::endl;
+    return 0;
+}
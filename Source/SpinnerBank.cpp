@@ -0,0 +1,163 @@
+/*
+  ==============================================================================
+
+    SpinnerBank.cpp
+
+  ==============================================================================
+*/
+
+#include "SpinnerBank.h"
+
+template <int NumSpinners>
+void SpinnerBank<NumSpinners>::load(int index, const Spinner& spinner)
+{
+    phase[index] = spinner.phase;
+    segmentTravel[index] = spinner.segmentTravel;
+    inverseSampleRate[index] = spinner.inverseSampleRate;
+    baseRate[index] = spinner.getBaseRate();
+    holdAccum[index] = spinner.holdAccum;
+
+    const LowPassGate* gates[] = { &spinner.forwardLPG, &spinner.backwardLPG, &spinner.brakeLPG };
+    Envelope* envelopes[] = { &forward, &backward, &brake };
+
+    for (int i = 0; i < 3; i++)
+    {
+        envelopes[i]->value[index] = gates[i]->getEnvelope();
+        envelopes[i]->gate[index] = gates[i]->getGate();
+        envelopes[i]->coefficient[index] = gates[i]->getCoefficient();
+    }
+}
+
+template <int NumSpinners>
+void SpinnerBank<NumSpinners>::store(int index, Spinner& spinner) const
+{
+    spinner.phase = phase[index];
+    spinner.previousPhase = phase[index];
+    spinner.segmentTravel = segmentTravel[index];
+
+    spinner.forwardLPG.setEnvelope(forward.value[index]);
+    spinner.backwardLPG.setEnvelope(backward.value[index]);
+    spinner.brakeLPG.setEnvelope(brake.value[index]);
+}
+
+template <int NumSpinners>
+bool SpinnerBank<NumSpinners>::isIdle(int lane) const
+{
+    return forward.value[lane] == forward.gate[lane]
+        && backward.value[lane] == backward.gate[lane]
+        && brake.value[lane] == brake.gate[lane];
+}
+
+template <int NumSpinners>
+void SpinnerBank<NumSpinners>::advance(int numSamples)
+{
+    // same schedule as Spinner::advance, a lane steps per sample in 32 sample
+    // blocks while its envelopes move and jumps in closed form once they settle
+    std::array<int, NumSpinners> steppedSamples = {};
+
+    int sample = 0;
+    while (sample < numSamples)
+    {
+        const int blockSize = std::min(numSamples - sample, envelopeBlockSize);
+        bool anyMoving = false;
+
+        for (int lane = 0; lane < NumSpinners; lane++)
+        {
+            const bool isMoving = !isIdle(lane);
+            stepping[lane] = (isMoving && !holdAccum[lane]) ? 1.0 : 0.0;
+
+            if (isMoving)
+                steppedSamples[lane] += blockSize;
+            anyMoving |= isMoving;
+        }
+
+        if (!anyMoving)
+            break;
+
+        processSamples(blockSize);
+        sample += blockSize;
+    }
+
+    for (int lane = 0; lane < NumSpinners; lane++)
+    {
+        const int remainingSamples = numSamples - steppedSamples[lane];
+        if (remainingSamples <= 0 || holdAccum[lane])
+            continue;
+
+        float nudgeValue = (forward.value[lane] + (backward.value[lane] * -1.0f)) * 10.0f;
+        float brakeLane = (1.0f - brake.value[lane]);
+        float rate = baseRate[lane] + nudgeValue;
+
+        double travel = ((rate * inverseSampleRate[lane]) * brakeLane) * remainingSamples;
+        phase[lane] += travel;
+        segmentTravel[lane] += travel;
+
+        if (phase[lane] >= 1.0f) phase[lane] -= std::floor(phase[lane]);
+    }
+}
+
+template <int NumSpinners>
+typename SpinnerBank<NumSpinners>::FloatRegister SpinnerBank<NumSpinners>::stepEnvelope(Envelope& envelope, int offset)
+{
+    // LowPassGate::generateEnvelope for a register of lanes
+    const auto gate = FloatRegister::fromRawArray(envelope.gate.data() + offset);
+    const auto coefficient = FloatRegister::fromRawArray(envelope.coefficient.data() + offset);
+    auto value = FloatRegister::fromRawArray(envelope.value.data() + offset);
+
+    value = gate + coefficient * (value - gate);
+    value = value & FloatRegister::greaterThanOrEqual(FloatRegister::abs(value), FloatRegister::expand(1e-15f));
+
+    const auto settled = FloatRegister::lessThan(FloatRegister::abs(value - gate), FloatRegister::expand(1e-6f));
+    value = (gate & settled) + (value & ~settled);
+
+    value.copyToRawArray(envelope.value.data() + offset);
+    return value;
+}
+
+template <int NumSpinners>
+void SpinnerBank<NumSpinners>::processSamples(int numSamples)
+{
+    const auto minusOne = FloatRegister::expand(-1.0f);
+    const auto ten = FloatRegister::expand(10.0f);
+    const auto oneFloat = FloatRegister::expand(1.0f);
+    const auto oneDouble = DoubleRegister::expand(1.0);
+
+    for (int sample = 0; sample < numSamples; sample++)
+    {
+        for (int lane = 0; lane < numLanes; lane += floatWidth)
+        {
+            const auto forwardValue = stepEnvelope(forward, lane);
+            const auto backwardValue = stepEnvelope(backward, lane);
+            const auto brakeEnvelope = stepEnvelope(brake, lane);
+
+            const auto nudgeValue = (forwardValue + (backwardValue * minusOne)) * ten;
+            const auto rate = FloatRegister::fromRawArray(baseRate.data() + lane) + nudgeValue;
+
+            rate.copyToRawArray(rateInHz.data() + lane);
+            (oneFloat - brakeEnvelope).copyToRawArray(brakeValue.data() + lane);
+        }
+
+        // the increment is accumulated in double like the scalar spinner
+        for (int lane = 0; lane < numLanes; lane++)
+        {
+            rateInHzWide[lane] = rateInHz[lane];
+            brakeValueWide[lane] = brakeValue[lane];
+        }
+
+        for (int lane = 0; lane < numLanes; lane += doubleWidth)
+        {
+            const auto rate = DoubleRegister::fromRawArray(rateInHzWide.data() + lane);
+            const auto brakeLane = DoubleRegister::fromRawArray(brakeValueWide.data() + lane);
+            const auto inverse = DoubleRegister::fromRawArray(inverseSampleRate.data() + lane);
+            const auto increment = ((rate * inverse) * brakeLane) * DoubleRegister::fromRawArray(stepping.data() + lane);
+
+            auto lanePhase = DoubleRegister::fromRawArray(phase.data() + lane) + increment;
+            lanePhase = lanePhase - (oneDouble & DoubleRegister::greaterThanOrEqual(lanePhase, oneDouble));
+
+            lanePhase.copyToRawArray(phase.data() + lane);
+            (DoubleRegister::fromRawArray(segmentTravel.data() + lane) + increment).copyToRawArray(segmentTravel.data() + lane);
+        }
+    }
+}
+
+template class SpinnerBank<numSpinners>;
@@ -0,0 +1,57 @@
+/*
+  ==============================================================================
+
+    SpinnerBank.h
+
+  ==============================================================================
+*/
+
+#pragma once
+#include <JuceHeader.h>
+#include "MIDIProcessor.h"
+
+// runs the scalar Spinner next to the bank and asserts both land on the same bits
+#ifndef TINGE_VERIFY_SPINNER_BANK
+ #define TINGE_VERIFY_SPINNER_BANK 0
+#endif
+
+// structure of arrays copy of the spinners' per sample state, advanced for all
+// spinners at once. Spinner keeps the control logic and stays the reference.
+template <int NumSpinners>
+class SpinnerBank
+{
+public:
+    void load(int index, const Spinner& spinner);
+    void store(int index, Spinner& spinner) const;
+    void advance(int numSamples);
+
+private:
+    using FloatRegister = juce::dsp::SIMDRegister<float>;
+    using DoubleRegister = juce::dsp::SIMDRegister<double>;
+
+    // float registers are never narrower than double ones, so this fills both
+    static constexpr int floatWidth = (int)FloatRegister::SIMDNumElements;
+    static constexpr int doubleWidth = (int)DoubleRegister::SIMDNumElements;
+    static constexpr int numLanes = ((NumSpinners + floatWidth - 1) / floatWidth) * floatWidth;
+    static constexpr int envelopeBlockSize = 32;
+
+    template <typename Type>
+    using Lanes = std::array<Type, numLanes>;
+
+    struct alignas (FloatRegister::SIMDRegisterSize) Envelope
+    {
+        Lanes<float> value {}, gate {}, coefficient {};
+    };
+
+    void processSamples(int numSamples);
+    static FloatRegister stepEnvelope(Envelope& envelope, int offset);
+    bool isIdle(int lane) const;
+
+    Envelope forward, backward, brake;
+
+    alignas (FloatRegister::SIMDRegisterSize) Lanes<float> baseRate {}, rateInHz {}, brakeValue {};
+    alignas (DoubleRegister::SIMDRegisterSize) Lanes<double> phase {}, segmentTravel {}, inverseSampleRate {};
+    alignas (DoubleRegister::SIMDRegisterSize) Lanes<double> rateInHzWide {}, brakeValueWide {}, stepping {};
+
+    Lanes<bool> holdAccum {};
+};
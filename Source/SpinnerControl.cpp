@@ -18,10 +18,16 @@ void SpinnerControlsLookAndFeel::setIndex(int index)
 void SpinnerControlsLookAndFeel::drawRotarySlider(juce::Graphics &g, int x, int y, int width, int height, float sliderPosProportional, float rotaryStartAngle, float rotaryEndAngle, juce::Slider &slider)
 {
     bool hover = slider.isMouseOver();
+    sprites.draw(g, slider.getLocalBounds(), spinnerIndex, sliderPosProportional, hover,
+                 [&] (juce::Graphics& sprite, float position) { renderRotarySlider(sprite, slider.getLocalBounds(), position, hover); });
+}
+
+void SpinnerControlsLookAndFeel::renderRotarySlider(juce::Graphics &g, juce::Rectangle<int> sliderBounds, float sliderPosProportional, bool hover)
+{
     primaryColor = !hover ? Colors::primaryColor[spinnerIndex] : Palette::addFloor(Colors::primaryColor[spinnerIndex], 0.05f);
     graphicGrey = !hover ? Colors::graphicGrey : Palette::addFloor(Colors::graphicGrey, 0.05f);
 
-    auto bounds = slider.getLocalBounds().toFloat();
+    auto bounds = sliderBounds.toFloat();
     bounds.reduce(5, 5);
     float xPos = bounds.getX();
     float yPos = bounds.getY();
@@ -57,8 +63,14 @@ void SpinnerControlsLookAndFeel::drawRotarySlider(juce::Graphics &g, int x, int
 
 void SpinnerControlsLookAndFeel::drawToggleButton(juce::Graphics& g, juce::ToggleButton& button, bool shouldDrawButtonAsHighlighted, bool shouldDrawButtonAsDown)
 {
-    auto bounds = button.getLocalBounds();
     bool hover = button.isMouseOver();
+    bool state = button.getToggleState();
+    sprites.draw(g, button.getLocalBounds(), spinnerIndex, 0.0f, hover | (state << 1),
+                 [&] (juce::Graphics& sprite, float) { renderToggleButton(sprite, button.getLocalBounds(), state, hover); });
+}
+
+void SpinnerControlsLookAndFeel::renderToggleButton(juce::Graphics& g, juce::Rectangle<int> bounds, bool state, bool hover)
+{
     primaryColor = !hover ? Colors::primaryColor[spinnerIndex] : Palette::addFloor(Colors::primaryColor[spinnerIndex], 0.05f);
     
     juce::Path graphicPath;
@@ -72,7 +84,7 @@ void SpinnerControlsLookAndFeel::drawToggleButton(juce::Graphics& g, juce::Toggl
                               true);
     
     g.setColour(primaryColor);
-    if (button.getToggleState()) { g.fillPath(graphicPath); }
+    if (state) { g.fillPath(graphicPath); }
     else { g.strokePath(graphicPath, juce::PathStrokeType(1.5f)); }
 }
 
@@ -292,10 +304,12 @@ SpinnerLayout::SpinnerLayout(TingeAudioProcessor &p, int index) : audioProcessor
     setSlider(*this, rateSyncDisplaySlider, rateLAF);
     rateSyncDisplaySlider.setVisible(!rateMode);
 
-    juce::String rateFreeID = "rateFree" + juce::String(index);
+    const int rateFreeIndex = ParameterRegistry::indexOf(ParameterRegistry::rateFree, index);
+    juce::String rateFreeID = ParameterRegistry::getID(rateFreeIndex);
     rateFreeAttachment = std::make_unique<juce::AudioProcessorValueTreeState::SliderAttachment>(audioProcessor.params->apvts, rateFreeID, rateFreeDisplaySlider);
     
-    juce::String rateSyncID = "rateSync" + juce::String(index);
+    const int rateSyncIndex = ParameterRegistry::indexOf(ParameterRegistry::rateSync, index);
+    juce::String rateSyncID = ParameterRegistry::getID(rateSyncIndex);
     rateSyncAttachment = std::make_unique<juce::AudioProcessorValueTreeState::SliderAttachment>(audioProcessor.params->apvts, rateSyncID, rateSyncDisplaySlider);
 
     // rate
@@ -303,18 +317,15 @@ SpinnerLayout::SpinnerLayout(TingeAudioProcessor &p, int index) : audioProcessor
     setLabel(*this, rateModeLabel, "Sync/Free", Colors::textColor, juce::Justification::left);
 
     // rate text slider
-    rateFreeTextSlider = std::make_unique<EditableTextBoxSlider>(audioProcessor, rateFreeID);
+    rateFreeTextSlider = std::make_unique<EditableTextBoxSlider>(audioProcessor, rateFreeIndex);
     addAndMakeVisible(*rateFreeTextSlider);
     rateFreeTextSlider->setFontSize(12.0f);
-    rateFreeTextSlider->setUnitStyle(UnitStyle::Hertz);
-    rateFreeTextSlider->setNumDecimals(2);
     rateFreeTextSlider->setJustification(juce::Justification::left);
     rateFreeTextSlider->setVisible(rateMode);
     
-    rateSyncTextSlider = std::make_unique<EditableTextBoxSlider>(audioProcessor, rateSyncID);
+    rateSyncTextSlider = std::make_unique<EditableTextBoxSlider>(audioProcessor, rateSyncIndex);
     addAndMakeVisible(*rateSyncTextSlider);
     rateSyncTextSlider->setFontSize(12.0f);
-    rateSyncTextSlider->setUnitStyle(UnitStyle::Sync);
     rateSyncTextSlider->setJustification(juce::Justification::left);
     rateSyncTextSlider->setVisible(!rateMode);
     
@@ -322,7 +333,7 @@ SpinnerLayout::SpinnerLayout(TingeAudioProcessor &p, int index) : audioProcessor
     setLabel(*this, phaseLabel, "Phase", Colors::textColor, juce::Justification::centred);
     phaseLAF.setIndex(index);
     setSlider(*this, phaseDialSlider, phaseLAF);
-    juce::String phaseID = "phase" + juce::String(index);
+    juce::String phaseID = ParameterRegistry::getID(ParameterRegistry::indexOf(ParameterRegistry::phase, index));
     phaseAttachment = std::make_unique<juce::AudioProcessorValueTreeState::SliderAttachment>(audioProcessor.params->apvts, phaseID, phaseDialSlider);
 
     
@@ -330,14 +341,14 @@ SpinnerLayout::SpinnerLayout(TingeAudioProcessor &p, int index) : audioProcessor
     setLabel(*this, opacityLabel, "Opacity", Colors::textColor, juce::Justification::centred);
     opacityLAF.setIndex(index);
     setSlider(*this, opacityDialSlider, opacityLAF);
-    juce::String opacityID = "opacity" + juce::String(index);
+    juce::String opacityID = ParameterRegistry::getID(ParameterRegistry::indexOf(ParameterRegistry::opacity, index));
     opacityAttachment = std::make_unique<juce::AudioProcessorValueTreeState::SliderAttachment>(audioProcessor.params->apvts, opacityID, opacityDialSlider);
 
     // shape
     setLabel(*this, curveLabel, "Curve", Colors::textColor, juce::Justification::centred);
     curveLAF.setIndex(index);
     setSlider(*this, curveDialSlider, curveLAF);
-    juce::String curveID = "curve" + juce::String(index);
+    juce::String curveID = ParameterRegistry::getID(ParameterRegistry::indexOf(ParameterRegistry::curve, index));
     curveAttachment = std::make_unique<juce::AudioProcessorValueTreeState::SliderAttachment>(audioProcessor.params->apvts, curveID, curveDialSlider);
 
 }
@@ -450,10 +461,9 @@ void SpinnerLayout::buttonClicked(juce::Button* b)
 {
         
      if (b == &rateModeButton){
-        juce::String rateModeID = "rateMode" + juce::String(index);
         bool rateMode = rateModeButton.getToggleState();
         float rateModeFloat = rateMode ? 0.0f : 1.0f;
-        audioProcessor.params->apvts.getParameter(rateModeID)->setValueNotifyingHost(rateModeFloat);
+        audioProcessor.params->getParameter(ParameterRegistry::rateMode, index)->setValueNotifyingHost(rateModeFloat);
          
         rateFreeDisplaySlider.setVisible(!rateMode);
         rateFreeTextSlider->setVisible(!rateMode);
@@ -467,7 +477,3 @@ bool SpinnerLayout::isMouseOver(juce::Point<int> mouse)
     auto bounds = getBounds();
     return bounds.contains(mouse);
 }
-
-void SpinnerLayout::timerCallback()
-{
-}
@@ -15,6 +15,7 @@
 #include "Graphics.h"
 #include "EditableTextSlider.h"
 #include "GraphicsHelper.h"
+#include "SpriteCache.h"
 
 enum class SpinnerControlsLAF { Rate, RateMode, Phase, Opacity, Curve };
 
@@ -43,6 +44,10 @@ public:
 
 
 private:
+    void renderRotarySlider(juce::Graphics &g, juce::Rectangle<int> sliderBounds, float sliderPosProportional, bool hover);
+    void renderToggleButton(juce::Graphics& g, juce::Rectangle<int> bounds, bool state, bool hover);
+    
+    SpriteCache sprites;
     float lineWidth = 1.5f;
     int spinnerIndex;
     SpinnerControlsLAF lookAndFeel;
@@ -51,7 +56,7 @@ private:
     
 };
 
-class SpinnerLayout : public juce::Component, public juce::Button::Listener, public juce::Timer, public GraphicsHelper
+class SpinnerLayout : public juce::Component, public juce::Button::Listener, public GraphicsHelper
 {
 public:
     SpinnerLayout(TingeAudioProcessor &p, int index);
@@ -65,8 +70,6 @@ public:
     bool isMouseOver(juce::Point<int> mouse);
 
 private:
-    void timerCallback() override;
-    
     int index;
     int hover;
     SpinnerControlsLookAndFeel
@@ -0,0 +1,94 @@
+/*
+  ==============================================================================
+
+    SpriteCache.h
+
+  ==============================================================================
+*/
+
+#pragma once
+#include <JuceHeader.h>
+
+// pre-rendered control images for the look and feel classes. a sprite is keyed
+// by control, quantised value, variant (hover, toggle state...) and size, and
+// rendered at the display's pixel scale, so repainting a knob is one image blit.
+// a scale change drops everything, a resize simply misses and the stale sizes
+// go when the cache fills up
+class SpriteCache
+{
+public:
+    // steps a 0-1 value snaps to, the renderer is handed the snapped value
+    static constexpr int valueSteps = 256;
+
+    // draws a sprite covering area, rendering it first if it isn't cached.
+    // the renderer draws with the same coordinates it would use without the cache
+    template <typename Renderer>
+    void draw(juce::Graphics& g, juce::Rectangle<int> area, int control, float value, int variant, Renderer&& render)
+    {
+        if (area.isEmpty())
+            return;
+
+        const float scale = g.getInternalContext().getPhysicalPixelScaleFactor();
+        if (scale != pixelScale)
+        {
+            clear();
+            pixelScale = scale;
+        }
+
+        const int step = juce::roundToInt(juce::jlimit(0.0f, 1.0f, value) * (valueSteps - 1));
+        const auto key = makeKey(control, step, variant, area);
+
+        auto sprite = sprites.find(key);
+        if (sprite == sprites.end())
+        {
+            auto image = renderSprite(area, (float)step / (valueSteps - 1), render);
+
+            const size_t bytes = (size_t)image.getWidth() * (size_t)image.getHeight() * 4;
+            if (totalBytes + bytes > maxBytes)
+                clear();
+
+            totalBytes += bytes;
+            sprite = sprites.emplace(key, std::move(image)).first;
+        }
+
+        g.drawImage(sprite->second, area.toFloat());
+    }
+
+    void clear()
+    {
+        sprites.clear();
+        totalBytes = 0;
+    }
+
+private:
+    static juce::uint64 makeKey(int control, int step, int variant, juce::Rectangle<int> area)
+    {
+        return ((juce::uint64)(control & 0xff) << 56)
+             | ((juce::uint64)(variant & 0xff) << 48)
+             | ((juce::uint64)(step & 0xffff) << 32)
+             | ((juce::uint64)(area.getWidth() & 0xffff) << 16)
+             | (juce::uint64)(area.getHeight() & 0xffff);
+    }
+
+    template <typename Renderer>
+    juce::Image renderSprite(juce::Rectangle<int> area, float value, Renderer& render) const
+    {
+        juce::Image image(juce::Image::ARGB,
+                          juce::jmax(1, juce::roundToInt(area.getWidth() * pixelScale)),
+                          juce::jmax(1, juce::roundToInt(area.getHeight() * pixelScale)),
+                          true);
+
+        juce::Graphics sprite(image);
+        sprite.addTransform(juce::AffineTransform::translation((float)-area.getX(), (float)-area.getY())
+                                .scaled(pixelScale));
+        render(sprite, value);
+        return image;
+    }
+
+    // per look and feel, about one full sweep of a knob at 2x
+    static constexpr size_t maxBytes = 16 * 1024 * 1024;
+
+    std::unordered_map<juce::uint64, juce::Image> sprites;
+    size_t totalBytes = 0;
+    float pixelScale = 0.0f;
+};
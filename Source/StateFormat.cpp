@@ -0,0 +1,111 @@
+/*
+  ==============================================================================
+
+    StateFormat.cpp
+
+  ==============================================================================
+*/
+
+#include "StateFormat.h"
+
+namespace StateFormat
+{
+    enum Flags { viewFlag = 1, controlFlag = 2 };
+
+    juce::uint32 getIdHash(const juce::String& id)
+    {
+        juce::uint32 hash = 2166136261u;
+        for (const char* c = id.toRawUTF8(); *c != 0; c++)
+            hash = (hash ^ (juce::uint32)(unsigned char)*c) * 16777619u;
+
+        return hash;
+    }
+
+    const std::array<juce::uint32, ParameterRegistry::numParameters>& getIdHashes()
+    {
+        static const auto hashes = []
+        {
+            std::array<juce::uint32, ParameterRegistry::numParameters> result {};
+            for (int i = 0; i < ParameterRegistry::numParameters; i++)
+            {
+                result[(size_t)i] = getIdHash(ParameterRegistry::getID(i));
+
+                // two ids sharing a hash would load each other's values, rename one
+                for (int j = 0; j < i; j++)
+                    jassert(result[(size_t)j] != result[(size_t)i]);
+            }
+            return result;
+        }();
+
+        return hashes;
+    }
+
+    void matchValues(const juce::HashMap<juce::uint32, float>& values, State& state)
+    {
+        const auto& hashes = getIdHashes();
+        for (int i = 0; i < ParameterRegistry::numParameters; i++)
+        {
+            const auto hash = hashes[(size_t)i];
+            state.values[(size_t)i] = values.contains(hash) ? values[hash] : ParameterRegistry::getDefault(i);
+        }
+    }
+
+    void write(const State& state, juce::MemoryBlock& destination)
+    {
+        juce::MemoryOutputStream stream(destination, false);
+
+        stream.writeInt((int)magic);
+        stream.writeInt((int)version);
+        stream.writeInt(ParameterRegistry::numParameters);
+
+        const auto& hashes = getIdHashes();
+        for (int i = 0; i < ParameterRegistry::numParameters; i++)
+        {
+            stream.writeInt((int)hashes[(size_t)i]);
+            stream.writeFloat(state.values[(size_t)i]);
+        }
+
+        stream.writeString(state.presetName);
+        stream.writeByte((char)((state.viewState ? viewFlag : 0) | (state.controlState ? controlFlag : 0)));
+    }
+
+    bool read(const void* data, int sizeInBytes, State& state)
+    {
+        constexpr int entrySize = (int)(sizeof(juce::uint32) + sizeof(float));
+
+        if (data == nullptr || sizeInBytes < 3 * (int)sizeof(juce::uint32) + 2)
+            return false;
+
+        juce::MemoryInputStream stream(data, (size_t)sizeInBytes, false);
+
+        if ((juce::uint32)stream.readInt() != magic)
+            return false;
+
+        if ((juce::uint32)stream.readInt() != version)
+        {
+            DBG("Binary state was written by a newer version");
+            return false;
+        }
+
+        const int numValues = stream.readInt();
+        if (numValues < 0 || stream.getNumBytesRemaining() < (juce::int64)numValues * entrySize + 2)
+            return false;
+
+        // ids this build doesn't know are skipped, ones it has that the state lacks get defaults
+        juce::HashMap<juce::uint32, float> values;
+        for (int i = 0; i < numValues; i++)
+        {
+            const auto hash = (juce::uint32)stream.readInt();
+            values.set(hash, stream.readFloat());
+        }
+
+        matchValues(values, state);
+
+        state.presetName = stream.readString();
+
+        const auto flags = stream.readByte();
+        state.viewState = (flags & viewFlag) != 0;
+        state.controlState = (flags & controlFlag) != 0;
+        return true;
+    }
+}
@@ -0,0 +1,42 @@
+/*
+  ==============================================================================
+
+    StateFormat.h
+
+  ==============================================================================
+*/
+
+#pragma once
+#include <JuceHeader.h>
+#include "ParameterRegistry.h"
+
+// packed session state: a small header, every parameter as a hash of its id
+// and its plain value, then the preset name and the editor flags. values are
+// matched back by id, so a state saved before parameters were added, removed
+// or moved still loads, parameters it doesn't have take their defaults
+namespace StateFormat
+{
+    constexpr juce::uint32 magic = 0x42474e54; // "TNGB"
+    constexpr juce::uint32 version = 1;
+
+    // fnv-1a of a parameter id
+    juce::uint32 getIdHash(const juce::String& id);
+
+    // the registry's id hashes, in table order
+    const std::array<juce::uint32, ParameterRegistry::numParameters>& getIdHashes();
+
+    struct State
+    {
+        std::array<float, ParameterRegistry::numParameters> values {};
+        juce::String presetName;
+        bool viewState = false, controlState = false;
+    };
+
+    void write(const State& state, juce::MemoryBlock& destination);
+
+    // false when the data isn't a binary state this build can read
+    bool read(const void* data, int sizeInBytes, State& state);
+
+    // plain values by id hash, parameters missing from them take their defaults
+    void matchValues(const juce::HashMap<juce::uint32, float>& values, State& state);
+}
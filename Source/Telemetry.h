@@ -0,0 +1,71 @@
+/*
+  ==============================================================================
+
+    Telemetry.h
+
+  ==============================================================================
+*/
+
+#pragma once
+#include <JuceHeader.h>
+#include "Config.h"
+
+// state of the engine at the end of a block, published for the editor
+struct TelemetrySnapshot
+{
+    std::array<float, numSpinners> phases {};
+    std::array<float, 16> heldPitches {};
+    std::array<float, 16> thresholdAngles {};
+    std::array<uint16_t, numSpinners> thresholdMasks {};
+    int numThresholds = 0;
+    uint16_t triggerMask = 0;
+    uint16_t noteOnMask = 0;
+};
+
+// single writer, single reader triple buffer. the writer never waits, the
+// reader always gets the latest complete snapshot and never a torn one.
+template <typename Type>
+class TripleBuffer
+{
+public:
+    TripleBuffer() = default;
+
+    // audio thread
+    Type& getWriteBuffer() noexcept
+    {
+        return buffers[writeIndex];
+    }
+
+    void publish() noexcept
+    {
+        writeIndex = middle.exchange((uint8_t)(writeIndex | freshBit), std::memory_order_acq_rel) & indexMask;
+    }
+
+    // message thread, true when read() would return something new
+    bool isFresh() const noexcept
+    {
+        return (middle.load(std::memory_order_relaxed) & freshBit) != 0;
+    }
+
+    // message thread, returns false when nothing was published since the last read
+    bool read(Type& destination) noexcept
+    {
+        const bool isFresh = (middle.load(std::memory_order_relaxed) & freshBit) != 0;
+
+        if (isFresh)
+            readIndex = middle.exchange(readIndex, std::memory_order_acq_rel) & indexMask;
+
+        destination = buffers[readIndex];
+        return isFresh;
+    }
+
+private:
+    static constexpr uint8_t indexMask = 0x3, freshBit = 0x4;
+    static_assert (std::atomic<uint8_t>::is_always_lock_free, "the telemetry channel must not fall back to a lock");
+
+    std::array<Type, 3> buffers {};
+    std::atomic<uint8_t> middle { 1 };
+    uint8_t writeIndex = 0, readIndex = 2;
+
+    JUCE_DECLARE_NON_COPYABLE (TripleBuffer)
+};
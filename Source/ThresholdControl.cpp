@@ -11,10 +11,16 @@
 #include "ThresholdControl.h"
 
 void ThresholdLookAndFeel::drawRotarySlider(juce::Graphics &g, int x, int y, int width, int height, float sliderPosProportional, float rotaryStartAngle, float rotaryEndAngle, juce::Slider &slider)
+{
+    bool hover = slider.isMouseOver();
+    sprites.draw(g, { x, y, width, height }, 0, sliderPosProportional, hover,
+                 [&] (juce::Graphics& sprite, float position) { renderRotarySlider(sprite, x, y, width, height, position, hover); });
+}
+
+void ThresholdLookAndFeel::renderRotarySlider(juce::Graphics &g, int x, int y, int width, int height, float sliderPosProportional, bool hover)
 {
     this->lineWidth = width * 0.02f;
     
-    bool hover = slider.isMouseOver();
     graphicGrey = !hover ? Colors::graphicGrey : Palette::addFloor(Colors::graphicGrey, 0.05f);
 
     juce::Rectangle<float> bounds = { (float)x, (float)y, (float)width, (float)height };
@@ -47,15 +53,21 @@ void ThresholdLookAndFeel::drawRotarySlider(juce::Graphics &g, int x, int y, int
 
 void ThresholdLookAndFeel::drawButtonBackground(juce::Graphics& g, juce::Button& button, const juce::Colour& backgroundColour, bool shouldDrawButtonAsHighlighted, bool shouldDrawButtonAsDown)
 {
-    auto bounds = button.getLocalBounds().toFloat();
+    bool hover = button.isMouseOver();
+    bool state = button.getToggleState();
+    sprites.draw(g, button.getLocalBounds(), 0, 0.0f, hover | (state << 1),
+                 [&] (juce::Graphics& sprite, float) { renderButton(sprite, button.getLocalBounds(), state, hover); });
+}
+
+void ThresholdLookAndFeel::renderButton(juce::Graphics& g, juce::Rectangle<int> buttonBounds, bool state, bool hover)
+{
+    auto bounds = buttonBounds.toFloat();
     float x = bounds.getX();
     float y = bounds.getY();
     float width = bounds.getWidth();
     
-    bool hover = button.isMouseOver();
     graphicGrey = !hover ? Colors::graphicGrey : Palette::addFloor(Colors::graphicGrey, 0.05f);
 
-    bool state = button.getToggleState();
     float alpha = state ? 1.0f : 0.25f;
     
     g.setColour(graphicGrey.withAlpha((float)alpha));
@@ -510,7 +522,7 @@ void ThresholdLayout::resized()
 
 void ThresholdLayout::buttonClicked(juce::Button* b)
 {
-    auto param = audioProcessor.params->apvts.getParameter("thresholdMode");
+    auto param = audioProcessor.params->getParameter(ParameterRegistry::thresholdMode);
     juce::StringArray thresholdModeChoice = {"Polygon", "Fill", "Harmonic", "Random", "Fibonacci" };
     for (int i = 0; i < 5; i++)
     {
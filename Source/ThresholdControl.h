@@ -17,6 +17,7 @@
 #include "InteractionLogic.h"
 #include "LookAndFeel.h"
 #include "ThresholdGraphics.h"
+#include "SpriteCache.h"
 
 class TingeAudioProcessor;
 
@@ -43,12 +44,16 @@ public:
     void drawFibonacciCube(juce::Graphics &g, float x, float y, float size, float rotation, float alpha);
     
 private:
+    void renderRotarySlider(juce::Graphics &g, int x, int y, int width, int height, float sliderPosProportional, bool hover);
+    void renderButton(juce::Graphics& g, juce::Rectangle<int> buttonBounds, bool state, bool hover);
+    
+    SpriteCache sprites;
     float lineWidth;
     juce::Colour graphicGrey;
     ThresholdLAF lookAndFeel;
 };
 
-class ThresholdLayout : public juce::Component, public juce::Button::Listener, public juce::Timer, public GraphicsHelper
+class ThresholdLayout : public juce::Component, public juce::Button::Listener, public GraphicsHelper
 {
 public:
     ThresholdLayout(TingeAudioProcessor &p);
@@ -65,8 +70,6 @@ public:
 
     ThresholdGraphics graphics;
 private:
-    void timerCallback() override {}
-    
     
     ThresholdLookAndFeel
     maxLAF { ThresholdLAF::Max },
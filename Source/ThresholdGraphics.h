@@ -13,7 +13,7 @@
 #include "InteractionLogic.h"
 #include "LookAndFeel.h"
 
-class ThresholdGraphics : public juce::Component, Interaction
+class ThresholdGraphics : public juce::Component, Interaction<editorSpinners>
 {
 public:
     void paint(juce::Graphics& g) override
@@ -92,6 +92,12 @@ public:
     
     void setParams(int mode, float startPhase, int maxThreshold)
     {
+        if (mode == lastMode && startPhase == lastStartPhase && maxThreshold == this->maxThreshold)
+            return;
+        
+        lastMode = mode;
+        lastStartPhase = startPhase;
+        
         float twopi = juce::MathConstants<float>::twoPi;
         this->startPhase = (startPhase/100.0f) * twopi;
         float originalStartPhase = startPhase;
@@ -99,7 +105,7 @@ public:
         this->maxThreshold = maxThreshold;
         
         Interaction::numThresholds = 16;
-        processThreshold(static_cast<MIDIProcessor::thresholdMode>(mode),
+        processThreshold(static_cast<thresholdMode>(mode),
                          originalStartPhase,
                          maxThreshold);
         repaint();
@@ -108,4 +114,7 @@ public:
 private:
     float startPhase = 3.14f;
     int maxThreshold = 15;
+    
+    int lastMode = -1;
+    float lastStartPhase = -1.0f;
 };
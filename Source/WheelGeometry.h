@@ -0,0 +1,147 @@
+/*
+  ==============================================================================
+
+    WheelGeometry.h
+
+  ==============================================================================
+*/
+
+#pragma once
+#include <JuceHeader.h>
+
+// the outline of one isometric wheel, sampled once per bounds and skew, plus
+// the last path built for each sector slot. sectors are slices of the outline,
+// so while the spinners stand still painting builds no paths at all
+template <int NumSectors>
+class WheelGeometry
+{
+public:
+    // outline points per turn, phases snap to these
+    static constexpr int resolution = 1024;
+
+    // a sector in outline steps, length 0 is empty
+    struct Arc
+    {
+        int start = 0, length = 0;
+    };
+
+    static Arc toArc(float phase, float lengthInTurns)
+    {
+        const int start = juce::roundToInt(phase * resolution) % resolution;
+        return { start < 0 ? start + resolution : start,
+                 juce::jlimit(0, resolution, juce::roundToInt(lengthInTurns * resolution)) };
+    }
+
+    // the part two sectors of the same wheel share, semicircles always meet in one piece
+    static Arc intersect(Arc a, Arc b)
+    {
+        Arc shared;
+        for (int offset = -resolution; offset <= resolution; offset += resolution)
+        {
+            const int start = std::max(a.start, b.start + offset);
+            const int end = std::min(a.start + a.length, b.start + b.length + offset);
+
+            if (end - start > shared.length)
+                shared = { ((start % resolution) + resolution) % resolution, end - start };
+        }
+        return shared;
+    }
+
+    void setBounds(juce::Rectangle<float> newBounds, float newSkew)
+    {
+        if (newBounds == bounds && newSkew == skew)
+            return;
+
+        bounds = newBounds;
+        skew = newSkew;
+
+        // same centre and radii as the addCentredArc calls this replaces
+        const float radius = bounds.getWidth() / 2;
+        centre = { bounds.getX() + radius, bounds.getY() + bounds.getHeight() / skew };
+
+        const auto& unit = getUnitOutline();
+        for (int i = 0; i < resolution; i++)
+            outline[i] = { centre.x + unit[i].x * radius, centre.y + unit[i].y * radius / skew };
+
+        for (auto& sector : sectors)
+            sector.arc.start = -1;
+    }
+
+    const juce::Path& getSector(int slot, Arc arc)
+    {
+        auto& sector = sectors[slot];
+        if (sector.arc.start == arc.start && sector.arc.length == arc.length)
+            return sector.path;
+
+        sector.arc = arc;
+        sector.path.clear();
+
+        if (arc.length >= 2)
+            buildSector(sector.path, arc);
+
+        return sector.path;
+    }
+
+private:
+    struct Sector
+    {
+        Arc arc { -1, 0 };
+        juce::Path path;
+    };
+
+    // juce arcs start at twelve o'clock and run clockwise
+    static const std::array<juce::Point<float>, resolution>& getUnitOutline()
+    {
+        static const auto unit = []
+        {
+            std::array<juce::Point<float>, resolution> points;
+            for (int i = 0; i < resolution; i++)
+            {
+                const float angle = juce::MathConstants<float>::twoPi * (float)i / resolution;
+                points[i] = { std::sin(angle), -std::cos(angle) };
+            }
+            return points;
+        }();
+        return unit;
+    }
+
+    const juce::Point<float>& rim(int step) const
+    {
+        return outline[(step % resolution + resolution) % resolution];
+    }
+
+    void buildSector(juce::Path& path, Arc arc) const
+    {
+        // rounds the centre and the two rim ends by a pixel, the rim between
+        // them is already smooth at this resolution
+        auto towards = [] (juce::Point<float> from, juce::Point<float> to, float distance)
+        {
+            const float length = from.getDistanceFrom(to);
+            return length > distance ? from + (to - from) * (distance / length) : (from + to) * 0.5f;
+        };
+
+        const auto& first = rim(arc.start);
+        const auto& last = rim(arc.start + arc.length);
+        const auto start = towards(centre, first, cornerRadius);
+
+        path.startNewSubPath(start);
+        path.lineTo(towards(first, centre, cornerRadius));
+        path.quadraticTo(first, rim(arc.start + 1));
+
+        for (int step = 2; step < arc.length; step++)
+            path.lineTo(rim(arc.start + step));
+
+        path.quadraticTo(last, towards(last, centre, cornerRadius));
+        path.lineTo(towards(centre, last, cornerRadius));
+        path.quadraticTo(centre, start);
+        path.closeSubPath();
+    }
+
+    static constexpr float cornerRadius = 1.0f;
+
+    juce::Rectangle<float> bounds;
+    float skew = 0.0f;
+    juce::Point<float> centre;
+    std::array<juce::Point<float>, resolution> outline;
+    std::array<Sector, NumSectors> sectors;
+};
@@ -0,0 +1,25 @@
+/*
+  ==============================================================================
+
+    Main.cpp
+
+  ==============================================================================
+*/
+
+#include <JuceHeader.h>
+
+// runs every test in the Tinge category, exits non-zero when any of them fails
+int main()
+{
+    const juce::ScopedJuceInitialiser_GUI juceInitialiser;
+
+    juce::UnitTestRunner runner;
+    runner.setAssertOnFailure(false);
+    runner.runTestsInCategory("Tinge");
+
+    int numFailures = 0;
+    for (int i = 0; i < runner.getNumResults(); i++)
+        numFailures += runner.getResult(i)->failures;
+
+    return numFailures == 0 ? 0 : 1;
+}
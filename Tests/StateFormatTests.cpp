@@ -0,0 +1,163 @@
+/*
+  ==============================================================================
+
+    StateFormatTests.cpp
+
+  ==============================================================================
+*/
+
+#include <JuceHeader.h>
+#include "../Source/PluginProcessor.h"
+#include "../Source/Presets.h"
+#include "../Source/StateFormat.h"
+
+// the binary session state against the apvts xml it replaced: both have to
+// restore the same values, also when the state comes from another parameter layout
+class StateFormatTests : public juce::UnitTest
+{
+public:
+    StateFormatTests() : juce::UnitTest("State format", "Tinge") {}
+
+    void runTest() override
+    {
+        const auto ccControl = ParameterRegistry::indexOf(ParameterRegistry::ccControl);
+
+        TingeAudioProcessor source;
+        randomise(source, 1);
+        source.params->apvts.state.setProperty(PresetManager::presetNameProperty, "Round Trip", nullptr);
+        source.saveEditorState(true, false);
+
+        beginTest("Binary round trip");
+        {
+            juce::MemoryBlock block;
+            source.getStateInformation(block);
+
+            TingeAudioProcessor destination;
+            randomise(destination, 2);
+            destination.setStateInformation(block.getData(), (int)block.getSize());
+
+            expectValues(getValues(destination), getValues(source));
+            expectEquals(destination.params->apvts.state.getProperty(PresetManager::presetNameProperty).toString(), juce::String("Round Trip"));
+            expect(destination.getEditorState().viewState);
+            expect(!destination.getEditorState().controlState);
+        }
+
+        beginTest("Binary and xml restore the same values");
+        {
+            juce::MemoryBlock binary, xml;
+            source.getStateInformation(binary);
+            source.copyXmlToBinary(*source.params->apvts.copyState().createXml(), xml);
+
+            TingeAudioProcessor fromBinary, fromXml;
+            randomise(fromBinary, 3);
+            randomise(fromXml, 4);
+            fromBinary.setStateInformation(binary.getData(), (int)binary.getSize());
+            fromXml.setStateInformation(xml.getData(), (int)xml.getSize());
+
+            expectValues(getValues(fromBinary), getValues(fromXml));
+        }
+
+        beginTest("An older layout loads by id");
+        {
+            // written by a build without ccControl, with a parameter since removed,
+            // and with the values in a different order
+            StateFormat::State state;
+            const auto values = getValues(source);
+
+            juce::MemoryBlock binary;
+            {
+                juce::MemoryOutputStream stream(binary, false);
+                stream.writeInt((int)StateFormat::magic);
+                stream.writeInt((int)StateFormat::version);
+                stream.writeInt(ParameterRegistry::numParameters);
+
+                stream.writeInt((int)StateFormat::getIdHash("retired"));
+                stream.writeFloat(42.0f);
+
+                for (int i = ParameterRegistry::numParameters; --i >= 0;)
+                {
+                    if (i == ccControl)
+                        continue;
+
+                    stream.writeInt((int)StateFormat::getIdHash(ParameterRegistry::getID(i)));
+                    stream.writeFloat(values[(size_t)i]);
+                }
+
+                stream.writeString("Old Layout");
+                stream.writeByte(0);
+            }
+
+            expect(StateFormat::read(binary.getData(), (int)binary.getSize(), state));
+            expectEquals(state.presetName, juce::String("Old Layout"));
+            expectEquals(state.values[(size_t)ccControl], ParameterRegistry::getDefault(ccControl));
+
+            // the same state as the xml an older build would have saved
+            auto tree = source.params->apvts.copyState();
+            tree.removeChild(tree.getChildWithProperty("id", ParameterRegistry::getID(ccControl)), nullptr);
+            tree.appendChild(juce::ValueTree { "PARAM", { { "id", "retired" }, { "value", 42.0f } } }, nullptr);
+
+            juce::MemoryBlock xml;
+            source.copyXmlToBinary(*tree.createXml(), xml);
+
+            TingeAudioProcessor fromBinary, fromXml;
+            randomise(fromBinary, 5);
+            randomise(fromXml, 6);
+
+            // so the default has to come from the load
+            fromBinary.params->getParameterByIndex(ccControl)->setValueNotifyingHost(1.0f);
+            fromXml.params->getParameterByIndex(ccControl)->setValueNotifyingHost(1.0f);
+            fromBinary.setStateInformation(binary.getData(), (int)binary.getSize());
+            fromXml.setStateInformation(xml.getData(), (int)xml.getSize());
+
+            auto expected = values;
+            expected[(size_t)ccControl] = ParameterRegistry::getDefault(ccControl);
+            expectValues(getValues(fromBinary), expected);
+            expectValues(getValues(fromXml), expected);
+        }
+
+        beginTest("Unreadable states are refused");
+        {
+            juce::MemoryBlock block;
+            source.getStateInformation(block);
+
+            StateFormat::State state;
+            expect(StateFormat::read(block.getData(), (int)block.getSize(), state));
+
+            // a newer format version
+            auto newer = block;
+            static_cast<char*>(newer.getData())[4]++;
+            expect(!StateFormat::read(newer.getData(), (int)newer.getSize(), state));
+
+            // cut short inside the values
+            expect(!StateFormat::read(block.getData(), 24, state));
+        }
+    }
+
+private:
+    static void randomise(TingeAudioProcessor& processor, juce::int64 seed)
+    {
+        juce::Random random { seed };
+        for (int i = 0; i < ParameterRegistry::numParameters; i++)
+            processor.params->getParameterByIndex(i)->setValueNotifyingHost(random.nextFloat());
+    }
+
+    static std::array<float, ParameterRegistry::numParameters> getValues(TingeAudioProcessor& processor)
+    {
+        std::array<float, ParameterRegistry::numParameters> values {};
+        for (int i = 0; i < ParameterRegistry::numParameters; i++)
+        {
+            const auto* parameter = processor.params->getParameterByIndex(i);
+            values[(size_t)i] = parameter->convertFrom0to1(parameter->getValue());
+        }
+        return values;
+    }
+
+    void expectValues(const std::array<float, ParameterRegistry::numParameters>& actual,
+                      const std::array<float, ParameterRegistry::numParameters>& expected)
+    {
+        for (int i = 0; i < ParameterRegistry::numParameters; i++)
+            expectWithinAbsoluteError(actual[(size_t)i], expected[(size_t)i], 1.0e-4f, ParameterRegistry::getID(i));
+    }
+};
+
+static StateFormatTests stateFormatTests;